@@ -191,4 +191,856 @@ void ownAlgorithm(std::vector<Task>& tasks) {
 
 void carlier(std::vector<Task>& tasks) {
 
-}
\ No newline at end of file
+}
+
+// Wczytuje krawędzie poprzedzań, zwraca false gdy plik nie istnieje lub jest
+// niekompletny.
+bool loadEdgesFromFile(const std::string& filename, std::vector<Edge>& edges) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << "\n";
+        return false;
+    }
+
+    int e;
+    if (!(file >> e) || e < 0) {
+        std::cerr << "Error: Invalid edge count in " << filename << "\n";
+        return false;
+    }
+    edges.resize(e);
+
+    for (int i = 0; i < e; ++i) {
+        if (!(file >> edges[i].from >> edges[i].to)) {
+            std::cerr << "Error: Expected " << e << " edges in " << filename << "\n";
+            return false;
+        }
+    }
+
+    file.close();
+    return true;
+}
+
+// Buduje listy następników w postaci CSR (succStart/succ) dla pozycji zadań
+// w wektorze tasks oraz liczbę poprzedników każdego zadania.
+static bool buildSuccessors(const std::vector<Task>& tasks, const std::vector<Edge>& edges,
+                            std::vector<int>& succStart, std::vector<int>& succ,
+                            std::vector<int>& predCount) {
+    int n = tasks.size();
+    std::vector<int> pos(n + 1, -1);
+    for (int i = 0; i < n; ++i) {
+        if (tasks[i].index < 1 || tasks[i].index > n) {
+            std::cerr << "Error: Task index " << tasks[i].index << " out of range\n";
+            return false;
+        }
+        pos[tasks[i].index] = i;
+    }
+
+    succStart.assign(n + 1, 0);
+    predCount.assign(n, 0);
+    for (const auto& edge : edges) {
+        if (edge.from < 1 || edge.from > n || edge.to < 1 || edge.to > n) {
+            std::cerr << "Error: Edge " << edge.from << " -> " << edge.to << " out of range\n";
+            return false;
+        }
+        ++succStart[pos[edge.from] + 1];
+        ++predCount[pos[edge.to]];
+    }
+    for (int i = 0; i < n; ++i) {
+        succStart[i + 1] += succStart[i];
+    }
+
+    succ.resize(edges.size());
+    std::vector<int> fill(succStart.begin(), succStart.end() - 1);
+    for (const auto& edge : edges) {
+        succ[fill[pos[edge.from]]++] = pos[edge.to];
+    }
+    return true;
+}
+
+// Porządek topologiczny (algorytm Kahna), zwraca false jeśli graf ma cykl.
+static bool topologicalOrder(const std::vector<int>& succStart, const std::vector<int>& succ,
+                             std::vector<int> predCount, std::vector<int>& order) {
+    int n = predCount.size();
+    order.clear();
+    order.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (predCount[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (size_t k = 0; k < order.size(); ++k) {
+        int u = order[k];
+        for (int e = succStart[u]; e < succStart[u + 1]; ++e) {
+            if (--predCount[succ[e]] == 0) {
+                order.push_back(succ[e]);
+            }
+        }
+    }
+    return (int)order.size() == n;
+}
+
+// Uzgadnia rj i qj z grafem poprzedzań: rj >= ri + pi oraz qi >= qj + pj dla
+// każdej krawędzi i -> j. Nie zmienia Cmax żadnej dopuszczalnej kolejności.
+bool adjustHeadsAndTails(std::vector<Task>& tasks, const std::vector<Edge>& edges) {
+    std::vector<int> succStart, succ, predCount, order;
+    if (!buildSuccessors(tasks, edges, succStart, succ, predCount)) {
+        return false;
+    }
+    if (!topologicalOrder(succStart, succ, predCount, order)) {
+        std::cerr << "Error: Precedence graph contains a cycle\n";
+        return false;
+    }
+
+    for (size_t k = 0; k < order.size(); ++k) {
+        int u = order[k];
+        for (int e = succStart[u]; e < succStart[u + 1]; ++e) {
+            Task& next = tasks[succ[e]];
+            next.rj = std::max(next.rj, tasks[u].rj + tasks[u].pj);
+        }
+    }
+    for (size_t k = order.size(); k-- > 0;) {
+        int u = order[k];
+        for (int e = succStart[u]; e < succStart[u + 1]; ++e) {
+            const Task& next = tasks[succ[e]];
+            tasks[u].qj = std::max(tasks[u].qj, next.qj + next.pj);
+        }
+    }
+    return true;
+}
+
+// Schrage dla 1|rj,qj,prec|Cmax: zadanie trafia do zbioru N dopiero po
+// zakończeniu wszystkich poprzedników. Złożoność O((n + e) log n).
+// Zwraca false (tasks bez zmian kolejności) dla cyklu lub złej krawędzi.
+bool schrageWithPrecedence(std::vector<Task>& tasks, const std::vector<Edge>& edges) {
+    if (!adjustHeadsAndTails(tasks, edges)) {
+        return false;
+    }
+    std::vector<int> succStart, succ, predCount;
+    buildSuccessors(tasks, edges, succStart, succ, predCount);
+
+    typedef std::pair<int, int> Key;
+    std::priority_queue<Key, std::vector<Key>, std::greater<Key> > N; // (rj, pozycja)
+    std::priority_queue<Key> G;                                       // (qj, pozycja)
+
+    int n = tasks.size();
+    for (int i = 0; i < n; ++i) {
+        if (predCount[i] == 0) {
+            N.push(Key(tasks[i].rj, i));
+        }
+    }
+
+    int currentTime = 0;
+    std::vector<Task> result;
+    result.reserve(n);
+
+    while (!G.empty() || !N.empty()) {
+        while (!N.empty() && N.top().first <= currentTime) {
+            G.push(Key(tasks[N.top().second].qj, N.top().second));
+            N.pop();
+        }
+
+        if (G.empty()) {
+            currentTime = N.top().first;
+        } else {
+            int u = G.top().second;
+            G.pop();
+            currentTime += tasks[u].pj;
+            result.push_back(tasks[u]);
+
+            for (int e = succStart[u]; e < succStart[u + 1]; ++e) {
+                if (--predCount[succ[e]] == 0) {
+                    N.push(Key(tasks[succ[e]].rj, succ[e]));
+                }
+            }
+        }
+    }
+
+    tasks = result;
+    return true;
+}
+
+
+// max(rj + pj + qj) - żadne zadanie nie skończy się wcześniej. O(n)
+int lbMaxTask(const std::vector<Task>& tasks) {
+    int bound = 0;
+    for (const auto& task : tasks) {
+        bound = std::max(bound, task.rj + task.pj + task.qj);
+    }
+    return bound;
+}
+
+// min r + suma p + min q - maszyna musi wykonać wszystkie zadania. O(n)
+int lbTotalLoad(const std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return 0;
+    }
+    int minR = std::numeric_limits<int>::max();
+    int minQ = std::numeric_limits<int>::max();
+    int sumP = 0;
+    for (const auto& task : tasks) {
+        minR = std::min(minR, task.rj);
+        minQ = std::min(minQ, task.qj);
+        sumP += task.pj;
+    }
+    return minR + sumP + minQ;
+}
+
+// Cmax optymalnego uszeregowania z przerywaniem (Schrage z podziałem zadań).
+// O(n log n)
+int lbPreemptive(const std::vector<Task>& tasks) {
+    std::vector<Task> N = tasks;
+    sortByRj(N);
+
+    typedef std::pair<int, int> Key; // (qj, pozostały czas pj)
+    std::priority_queue<Key> G;
+
+    int n = N.size();
+    int currentTime = 0;
+    int cmax = 0;
+    int i = 0;
+
+    while (i < n || !G.empty()) {
+        if (G.empty()) {
+            currentTime = std::max(currentTime, N[i].rj);
+        }
+        while (i < n && N[i].rj <= currentTime) {
+            G.push(Key(N[i].qj, N[i].pj));
+            ++i;
+        }
+
+        Key top = G.top();
+        G.pop();
+        int nextRelease = (i < n) ? N[i].rj : std::numeric_limits<int>::max();
+        if (currentTime + top.second <= nextRelease) {
+            currentTime += top.second;
+            cmax = std::max(cmax, currentTime + top.first);
+        } else {
+            top.second -= nextRelease - currentTime;
+            currentTime = nextRelease;
+            G.push(top);
+        }
+    }
+
+    return cmax;
+}
+
+// h(K) = min r + suma p + min q dla podzbioru K
+static int blockBound(const std::vector<Task>& tasks, int from, int to) {
+    std::vector<Task> block(tasks.begin() + from, tasks.begin() + to);
+    return lbTotalLoad(block);
+}
+
+// Ograniczenie z bloku krytycznego uszeregowania Schrage (jak w algorytmie
+// Carliera): h(K), h(K + c) oraz ograniczenie z przerywaniem dla obu gałęzi
+// "c przed K" / "c po K". O(n log n)
+int lbCriticalBlock(const std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return 0;
+    }
+    std::vector<Task> order = tasks;
+    schrageWithPrecedence(order, std::vector<Edge>());
+    int n = order.size();
+
+    std::vector<int> completion(n);
+    int currentTime = 0;
+    int cmax = 0;
+    int b = 0;
+    for (int j = 0; j < n; ++j) {
+        currentTime = std::max(currentTime, order[j].rj) + order[j].pj;
+        completion[j] = currentTime;
+        if (currentTime + order[j].qj >= cmax) {
+            cmax = currentTime + order[j].qj;
+            b = j;
+        }
+    }
+
+    // a - początek bloku bez przestojów kończącego się na zadaniu b (przed a
+    // maszyna stała, więc ra <= rj dla całego bloku)
+    int a = b;
+    while (a > 0 && completion[a - 1] >= order[a].rj) {
+        --a;
+    }
+    int c = -1;
+    for (int j = b - 1; j >= a; --j) {
+        if (order[j].qj < order[b].qj) {
+            c = j;
+            break;
+        }
+    }
+    if (c < 0) {
+        return cmax; // uszeregowanie Schrage jest optymalne
+    }
+
+    int bound = std::max(blockBound(order, c + 1, b + 1), blockBound(order, c, b + 1));
+
+    int minR = std::numeric_limits<int>::max();
+    int minQ = std::numeric_limits<int>::max();
+    int sumP = 0;
+    for (int j = c + 1; j <= b; ++j) {
+        minR = std::min(minR, order[j].rj);
+        minQ = std::min(minQ, order[j].qj);
+        sumP += order[j].pj;
+    }
+    Task interference = order[c];
+    order[c].rj = std::max(interference.rj, minR + sumP);
+    int after = lbPreemptive(order);
+    order[c] = interference;
+    order[c].qj = std::max(interference.qj, sumP + minQ);
+    int before = lbPreemptive(order);
+
+    // Lepsze od Schrage uszeregowanie ma c przed albo po całym bloku K.
+    bound = std::max(bound, std::min(cmax, std::min(after, before)));
+    return std::max(bound, lbPreemptive(tasks));
+}
+
+const std::vector<LowerBound>& lowerBounds() {
+    static const std::vector<LowerBound> bounds = {
+        {"max(r+p+q)", lbMaxTask},
+        {"minR+sumP+minQ", lbTotalLoad},
+        {"preemptive", lbPreemptive},
+        {"criticalBlock", lbCriticalBlock},
+    };
+    return bounds;
+}
+
+// Liczy kolejne ograniczenia i kończy, gdy tylko któreś osiągnie incumbent
+// (węzeł można wtedy odciąć). Zwraca najlepsze uzyskane ograniczenie.
+int cascadeLowerBound(const std::vector<Task>& tasks, int incumbent, int* levelsUsed) {
+    const std::vector<LowerBound>& bounds = lowerBounds();
+    int best = 0;
+    size_t level = 0;
+    while (level < bounds.size()) {
+        best = std::max(best, bounds[level].compute(tasks));
+        ++level;
+        if (best >= incumbent) {
+            break;
+        }
+    }
+    if (levelsUsed) {
+        *levelsUsed = level;
+    }
+    return best;
+}
+
+void benchmarkLowerBounds(const std::vector<std::string>& files) {
+    const std::vector<LowerBound>& bounds = lowerBounds();
+    const int repeats = 100;
+
+    for (const auto& file : files) {
+        std::vector<Task> tasks;
+        loadTasksFromFile(file, tasks);
+        if (tasks.empty()) {
+            continue;
+        }
+        std::vector<Task> order = tasks;
+        schrageWithPrecedence(order, std::vector<Edge>());
+        int upper = calculateCmax(order);
+
+        std::cout << file << " (n=" << tasks.size() << ", Schrage Cmax: " << upper << ")\n";
+        for (const auto& bound : bounds) {
+            int value = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < repeats; ++r) {
+                value = bound.compute(tasks);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / repeats;
+            std::cout << "  " << bound.name << ": LB=" << value
+                      << ", LB/UB=" << (100.0 * value / upper) << "%"
+                      << ", Time: " << ns << " ns\n";
+        }
+
+        int levels = 0;
+        int value = cascadeLowerBound(tasks, upper, &levels);
+        std::cout << "  cascade: LB=" << value << ", levels: " << levels << "\n";
+    }
+}
+
+
+// Dominacja dla zadań o równym pj: jeśli ri <= rj i qi >= qj, to istnieje
+// optymalna kolejność z i przed j (zamiana miejscami niczego nie psuje).
+// Remisy rozstrzyga kolejność sortowania, więc graf jest acykliczny. Nie
+// wszystkie pary dostają krawędź - każde zadanie j dostaje krawędź od
+// dominującego je zadania o największym ri (najmocniej podnosi rj) i do
+// zdominowanego przez nie zadania o największym qj (najmocniej podnosi qi).
+// Po adjustHeadsAndTails każde rj >= ri + p i qi >= qj + p dla każdej pary
+// dominacji; ograniczenia wynikające z dłuższych łańcuchów dominacji mogą
+// być słabsze niż przy pełnym grafie. Najwyżej 2(k - 1) krawędzi na grupę
+// k zadań zamiast k^2.
+void dominanceEdges(const std::vector<Task>& tasks, std::vector<Edge>& edges) {
+    std::vector<Task> sorted = tasks;
+    std::sort(sorted.begin(), sorted.end(), [](const Task& a, const Task& b) {
+        if (a.pj != b.pj) return a.pj < b.pj;
+        if (a.rj != b.rj) return a.rj < b.rj;
+        if (a.qj != b.qj) return a.qj > b.qj;
+        return a.index < b.index;
+    });
+
+    edges.clear();
+    std::vector<Edge> group;
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while (j < sorted.size() && sorted[j].pj == sorted[i].pj) {
+            ++j;
+        }
+        group.clear();
+        // Głowy: wcześniejsze zadania o qi >= qj, wybierane najpóźniejsze (ma
+        // największe ri). Zadanie o qi <= qb sprzed b nie będzie już wybrane,
+        // więc w mapie qi rośnie, a kolejność dodania maleje.
+        std::map<int, int> latest;
+        for (size_t b = i; b < j; ++b) {
+            std::map<int, int>::iterator it = latest.lower_bound(sorted[b].qj);
+            if (it != latest.end()) {
+                group.push_back({it->second, sorted[b].index});
+            }
+            latest.erase(latest.begin(), latest.upper_bound(sorted[b].qj));
+            latest[sorted[b].qj] = sorted[b].index;
+        }
+        // Ogony: późniejsze zadania o qj <= qa, wybierane o największym qj.
+        std::map<int, int> later;
+        for (size_t a = j; a-- > i;) {
+            std::map<int, int>::iterator it = later.upper_bound(sorted[a].qj);
+            if (it != later.begin()) {
+                group.push_back({sorted[a].index, std::prev(it)->second});
+            }
+            later[sorted[a].qj] = sorted[a].index;
+        }
+        std::sort(group.begin(), group.end(), [](const Edge& x, const Edge& y) {
+            return x.from != y.from ? x.from < y.from : x.to < y.to;
+        });
+        for (size_t e = 0; e < group.size(); ++e) {
+            if (e == 0 || group[e].from != group[e - 1].from || group[e].to != group[e - 1].to) {
+                edges.push_back(group[e]);
+            }
+        }
+        i = j;
+    }
+}
+
+// Dzieli blok w miejscach, w których zadania "wcześniejsze" kończą się w
+// każdej kolejności, zanim którekolwiek "późniejsze" stanie się dostępne.
+// Dla mirror == true to samo w czasie odwróconym (qj zamiast rj).
+static bool splitBlock(std::vector<Task>& block, bool mirror, std::vector<std::vector<Task> >& parts) {
+    if (mirror) {
+        sortByQj(block, true);
+    } else {
+        sortByRj(block, true);
+    }
+
+    std::vector<std::vector<Task> > pieces;
+    size_t begin = 0;
+    int sumP = 0;
+    for (size_t k = 0; k < block.size(); ++k) {
+        sumP += block[k].pj;
+        int release = mirror ? block[k].qj : block[k].rj;
+        if (k + 1 < block.size()) {
+            int nextRelease = mirror ? block[k + 1].qj : block[k + 1].rj;
+            if (release + sumP > nextRelease) {
+                continue;
+            }
+        }
+        pieces.push_back(std::vector<Task>(block.begin() + begin, block.begin() + k + 1));
+        begin = k + 1;
+        sumP = 0;
+    }
+
+    if (mirror) {
+        std::reverse(pieces.begin(), pieces.end());
+    }
+    for (auto& piece : pieces) {
+        parts.push_back(piece);
+    }
+    return pieces.size() > 1;
+}
+
+// Zaostrza rj/qj krawędziami dominacji i dzieli instancję na niezależne
+// podinstancje. Bloki są w kolejności, w jakiej należy je wykonać, a
+// sklejenie optymalnych kolejności bloków daje kolejność optymalną.
+void decomposeInstance(const std::vector<Task>& tasks, std::vector<std::vector<Task> >& blocks) {
+    std::vector<Task> tightened = tasks;
+    std::vector<Edge> edges;
+    dominanceEdges(tightened, edges);
+    adjustHeadsAndTails(tightened, edges);
+
+    blocks.clear();
+    std::vector<std::vector<Task> > pending(1, tightened);
+    bool mirror = false;
+    int unchangedRounds = 0;
+    while (unchangedRounds < 2) {
+        std::vector<std::vector<Task> > next;
+        bool changed = false;
+        for (auto& block : pending) {
+            if (splitBlock(block, mirror, next)) {
+                changed = true;
+            }
+        }
+        pending.swap(next);
+        unchangedRounds = changed ? 0 : unchangedRounds + 1;
+        mirror = !mirror;
+    }
+    blocks = pending;
+}
+
+// Rozwiązuje podinstancje niezależnie (równolegle) podanym algorytmem, np.
+// findOptimalTaskOrder. Zwraca liczbę podinstancji.
+int solveDecomposed(std::vector<Task>& tasks, void (*solver)(std::vector<Task>&), int numThreads) {
+    std::vector<Task> original = tasks;
+    std::sort(original.begin(), original.end(), [](const Task& a, const Task& b) {
+        return a.index < b.index;
+    });
+
+    std::vector<std::vector<Task> > blocks;
+    decomposeInstance(tasks, blocks);
+
+    // Największe bloki najpierw, żeby wątki kończyły mniej więcej razem.
+    std::vector<size_t> queue(blocks.size());
+    for (size_t i = 0; i < queue.size(); ++i) {
+        queue[i] = i;
+    }
+    std::sort(queue.begin(), queue.end(), [&blocks](size_t a, size_t b) {
+        return blocks[a].size() > blocks[b].size();
+    });
+
+    std::mutex queueMutex;
+    size_t nextBlock = 0;
+    auto worker = [&]() {
+        while (true) {
+            size_t b;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (nextBlock == queue.size()) {
+                    return;
+                }
+                b = queue[nextBlock++];
+            }
+            if (blocks[b].size() > 1) {
+                solver(blocks[b]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Zaostrzone rj/qj służyły tylko do podziału - przywracamy oryginalne.
+    tasks.clear();
+    for (const auto& block : blocks) {
+        for (const auto& task : block) {
+            tasks.push_back(original[task.index - 1]);
+        }
+    }
+    return blocks.size();
+}
+
+
+// Wyżarzanie z wymianą replik (parallel tempering). Każda replika trzyma
+// głowy (czas zakończenia i Cmax prefiksu) oraz ogony: sufiks od pozycji k
+// rozpoczęty w chwili t daje Cmax = max(t + tailA[k], tailB[k]). Dzięki temu
+// ruch zamiany/wstawienia w oknie o długości ANNEALING_WINDOW ocenia się w
+// czasie stałym, bez liczenia calculateCmax.
+static const int ANNEALING_WINDOW = 16;
+static const int NEG_INF = std::numeric_limits<int>::min() / 4;
+
+struct AnnealingReplica {
+    std::vector<Task> order;
+    std::vector<int> head;
+    std::vector<int> headMax;
+    std::vector<int> tailA;
+    std::vector<int> tailB;
+    std::vector<Task> best;
+    int bestCmax;
+    std::mt19937 rng;
+};
+
+// Przelicza głowy od pozycji from; za pozycją stopAfter kończy, gdy tylko
+// wartości zgadzają się z poprzednimi.
+static void updateHeads(AnnealingReplica& s, int from, int stopAfter) {
+    int n = s.order.size();
+    int time = from > 0 ? s.head[from - 1] : 0;
+    int cmax = from > 0 ? s.headMax[from - 1] : 0;
+    for (int k = from; k < n; ++k) {
+        time = std::max(time, s.order[k].rj) + s.order[k].pj;
+        cmax = std::max(cmax, time + s.order[k].qj);
+        if (k > stopAfter && s.head[k] == time && s.headMax[k] == cmax) {
+            return;
+        }
+        s.head[k] = time;
+        s.headMax[k] = cmax;
+    }
+}
+
+// Przelicza ogony od pozycji from w dół; przed pozycją stopBefore kończy,
+// gdy tylko wartości zgadzają się z poprzednimi.
+static void updateTails(AnnealingReplica& s, int from, int stopBefore) {
+    int n = s.order.size();
+    int a = from + 1 < n ? s.tailA[from + 1] : NEG_INF;
+    int b = from + 1 < n ? s.tailB[from + 1] : NEG_INF;
+    for (int k = from; k >= 0; --k) {
+        a = s.order[k].pj + std::max(s.order[k].qj, a);
+        b = std::max(s.order[k].rj + a, b);
+        if (k < stopBefore && s.tailA[k] == a && s.tailB[k] == b) {
+            return;
+        }
+        s.tailA[k] = a;
+        s.tailB[k] = b;
+    }
+}
+
+// Cmax po zastąpieniu pozycji lo..hi zadaniami segment[0..hi-lo].
+static int evaluateSegment(const AnnealingReplica& s, int lo, int hi, const Task* segment) {
+    int n = s.order.size();
+    int time = lo > 0 ? s.head[lo - 1] : 0;
+    int cmax = lo > 0 ? s.headMax[lo - 1] : 0;
+    for (int k = 0; k <= hi - lo; ++k) {
+        time = std::max(time, segment[k].rj) + segment[k].pj;
+        cmax = std::max(cmax, time + segment[k].qj);
+    }
+    if (hi + 1 < n) {
+        cmax = std::max(cmax, std::max(time + s.tailA[hi + 1], s.tailB[hi + 1]));
+    }
+    return cmax;
+}
+
+static void annealReplica(AnnealingReplica& s, double temperature, int moves) {
+    int n = s.order.size();
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    Task segment[ANNEALING_WINDOW + 1];
+
+    for (int move = 0; move < moves; ++move) {
+        int lo = s.rng() % n;
+        int hi = std::min(n - 1, lo + 1 + (int)(s.rng() % ANNEALING_WINDOW));
+        if (lo == hi) {
+            continue;
+        }
+        int kind = s.rng() % 3; // 0 - zamiana, 1 - wstawienie w prawo, 2 - w lewo
+        int len = hi - lo + 1;
+        if (kind == 0) {
+            std::copy(s.order.begin() + lo, s.order.begin() + hi + 1, segment);
+            std::swap(segment[0], segment[len - 1]);
+        } else if (kind == 1) {
+            std::copy(s.order.begin() + lo + 1, s.order.begin() + hi + 1, segment);
+            segment[len - 1] = s.order[lo];
+        } else {
+            segment[0] = s.order[hi];
+            std::copy(s.order.begin() + lo, s.order.begin() + hi, segment + 1);
+        }
+
+        int current = s.headMax[n - 1];
+        int candidate = evaluateSegment(s, lo, hi, segment);
+        int delta = candidate - current;
+        if (delta > 0 && uniform(s.rng) >= std::exp(-delta / temperature)) {
+            continue;
+        }
+
+        std::copy(segment, segment + len, s.order.begin() + lo);
+        updateHeads(s, lo, hi);
+        updateTails(s, hi, lo);
+        if (candidate < s.bestCmax) {
+            s.bestCmax = candidate;
+            s.best = s.order;
+        }
+    }
+}
+
+// Zwraca liczbę wykonanych epok; w tasks zostaje najlepsza znaleziona kolejność.
+int parallelTempering(std::vector<Task>& tasks, int timeBudgetMs, int numThreads) {
+    int n = tasks.size();
+    if (n < 2) {
+        return 0;
+    }
+    const int movesPerEpoch = 20000;
+    int replicas = std::max(2, numThreads);
+
+    std::vector<Task> start = tasks;
+    schrageWithPrecedence(start, std::vector<Edge>());
+
+    // Temperatury w ciągu geometrycznym od średniego pj do 1/50 tej wartości.
+    double meanP = 0;
+    for (const auto& task : tasks) {
+        meanP += task.pj;
+    }
+    meanP /= n;
+    std::vector<double> temperature(replicas);
+    for (int k = 0; k < replicas; ++k) {
+        temperature[k] = meanP * std::pow(0.02, (double)k / (replicas - 1));
+    }
+
+    std::vector<AnnealingReplica> state(replicas);
+    for (int k = 0; k < replicas; ++k) {
+        AnnealingReplica& s = state[k];
+        s.order = start;
+        s.head.assign(n, 0);
+        s.headMax.assign(n, 0);
+        s.tailA.assign(n, 0);
+        s.tailB.assign(n, 0);
+        updateHeads(s, 0, n);
+        updateTails(s, n - 1, -1);
+        s.best = start;
+        s.bestCmax = s.headMax[n - 1];
+        s.rng.seed(12345 + k);
+    }
+
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    auto begin = std::chrono::steady_clock::now();
+    int epochs = 0;
+
+    while (std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(timeBudgetMs)) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads && t < replicas; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                for (int k = t; k < replicas; k += numThreads) {
+                    annealReplica(state[k], temperature[k], movesPerEpoch);
+                }
+            }));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Wymiana stanów sąsiednich temperatur (kryterium Metropolisa).
+        for (int k = epochs % 2; k + 1 < replicas; k += 2) {
+            double energyDiff = state[k].headMax[n - 1] - state[k + 1].headMax[n - 1];
+            double beta = 1.0 / temperature[k] - 1.0 / temperature[k + 1];
+            if (energyDiff * beta >= 0 || uniform(rng) < std::exp(energyDiff * beta)) {
+                std::swap(state[k].order, state[k + 1].order);
+                std::swap(state[k].head, state[k + 1].head);
+                std::swap(state[k].headMax, state[k + 1].headMax);
+                std::swap(state[k].tailA, state[k + 1].tailA);
+                std::swap(state[k].tailB, state[k + 1].tailB);
+            }
+        }
+        ++epochs;
+    }
+
+    int bestReplica = 0;
+    for (int k = 1; k < replicas; ++k) {
+        if (state[k].bestCmax < state[bestReplica].bestCmax) {
+            bestReplica = k;
+        }
+    }
+    tasks = state[bestReplica].best;
+    return epochs;
+}
+
+
+// Schrage dla BATCH_LANES instancji o tym samym rozmiarze naraz. Dane są
+// ułożone jako [zadanie][instancja], więc każda pętla po "lane" to jedna
+// operacja wektorowa. Wykonane zadanie dostaje rj = INT_MAX. O(n^2) na
+// instancję, ale bez kopców i rozgałęzień - dla n <= ~100 to się opłaca.
+static void schrageLanes(std::vector<std::vector<Task> >& instances, const int* ids, int* cmax) {
+    const int L = BATCH_LANES;
+    const int INF = std::numeric_limits<int>::max();
+    int n = instances[ids[0]].size();
+
+    std::vector<int> r(n * L), p(n * L), q(n * L), order(n * L);
+    for (int l = 0; l < L; ++l) {
+        const std::vector<Task>& tasks = instances[ids[l]];
+        for (int j = 0; j < n; ++j) {
+            r[j * L + l] = tasks[j].rj;
+            p[j * L + l] = tasks[j].pj;
+            q[j * L + l] = tasks[j].qj;
+        }
+    }
+    std::vector<int> pending = r;
+
+    int time[L] = {0};
+    for (int step = 0; step < n; ++step) {
+        int minR[L];
+        for (int l = 0; l < L; ++l) {
+            minR[l] = INF;
+        }
+        for (int j = 0; j < n; ++j) {
+            const int* rj = &pending[j * L];
+            for (int l = 0; l < L; ++l) {
+                minR[l] = std::min(minR[l], rj[l]);
+            }
+        }
+        for (int l = 0; l < L; ++l) {
+            time[l] = std::max(time[l], minR[l]);
+        }
+
+        int bestQ[L], bestJ[L];
+        for (int l = 0; l < L; ++l) {
+            bestQ[l] = -1;
+            bestJ[l] = 0;
+        }
+        // Remis qj wygrywa późniejsze zadanie, jak w kopcu par (qj, pozycja)
+        // w schrageWithPrecedence, więc obie ścieżki dają tę samą kolejność.
+        for (int j = 0; j < n; ++j) {
+            const int* rj = &pending[j * L];
+            const int* qj = &q[j * L];
+            for (int l = 0; l < L; ++l) {
+                bool better = (rj[l] <= time[l]) & (qj[l] >= bestQ[l]);
+                bestQ[l] = better ? qj[l] : bestQ[l];
+                bestJ[l] = better ? j : bestJ[l];
+            }
+        }
+
+        for (int l = 0; l < L; ++l) {
+            int j = bestJ[l];
+            order[step * L + l] = j;
+            time[l] += p[j * L + l];
+            pending[j * L + l] = INF;
+        }
+    }
+
+    int current[L] = {0};
+    int result[L] = {0};
+    for (int step = 0; step < n; ++step) {
+        for (int l = 0; l < L; ++l) {
+            int j = order[step * L + l] * L + l;
+            current[l] = std::max(current[l], r[j]) + p[j];
+            result[l] = std::max(result[l], current[l] + q[j]);
+        }
+    }
+
+    for (int l = 0; l < L; ++l) {
+        std::vector<Task>& tasks = instances[ids[l]];
+        std::vector<Task> scheduled(n);
+        for (int step = 0; step < n; ++step) {
+            scheduled[step] = tasks[order[step * L + l]];
+        }
+        tasks.swap(scheduled);
+        cmax[l] = result[l];
+    }
+}
+
+// Szereguje wiele instancji algorytmem Schrage. Instancje o równym rozmiarze
+// idą paczkami po BATCH_LANES, reszta skalarnie (schrageWithPrecedence).
+void batchSchrage(std::vector<std::vector<Task> >& instances, std::vector<int>& cmax) {
+    cmax.assign(instances.size(), 0);
+
+    std::vector<int> bySize(instances.size());
+    for (size_t i = 0; i < bySize.size(); ++i) {
+        bySize[i] = i;
+    }
+    std::stable_sort(bySize.begin(), bySize.end(), [&instances](int a, int b) {
+        return instances[a].size() < instances[b].size();
+    });
+
+    size_t i = 0;
+    while (i < bySize.size()) {
+        size_t j = i;
+        while (j < bySize.size() && instances[bySize[j]].size() == instances[bySize[i]].size()) {
+            ++j;
+        }
+        for (; i + BATCH_LANES <= j; i += BATCH_LANES) {
+            int result[BATCH_LANES];
+            schrageLanes(instances, &bySize[i], result);
+            for (int l = 0; l < BATCH_LANES; ++l) {
+                cmax[bySize[i + l]] = result[l];
+            }
+        }
+        for (; i < j; ++i) {
+            schrageWithPrecedence(instances[bySize[i]], std::vector<Edge>());
+            cmax[bySize[i]] = calculateCmax(instances[bySize[i]]);
+        }
+    }
+}
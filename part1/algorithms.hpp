@@ -11,6 +11,11 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <queue>
+#include <map>
+#include <functional>
+#include <random>
+#include <cmath>
 
 struct Task {
     int index;
@@ -19,6 +24,23 @@ struct Task {
     int pj; 
 };
 
+// Dolne ograniczenie Cmax, kolejne ograniczenia w lowerBounds() są coraz
+// droższe i coraz silniejsze.
+struct LowerBound {
+    const char* name;
+    int (*compute)(const std::vector<Task>& tasks);
+};
+
+// Liczba instancji liczonych jednocześnie w batchSchrage (szerokość wektora).
+const int BATCH_LANES = 8;
+
+// Ograniczenie kolejności: zadanie "from" musi zostać wykonane przed "to"
+// (indeksy zadań jak w Task::index).
+struct Edge {
+    int from;
+    int to;
+};
+
 void loadTasksFromFile(const std::string& filename, std::vector<Task>& tasks);
 void findOptimalOrder(std::vector<Task>& tasks);
 void sortByRj(std::vector<Task>& tasks, bool ascending);
@@ -31,6 +53,21 @@ void findOptimalTaskOrderWithThreads(std::vector<Task>& tasks, int numThreads);
 void schrage(std::vector<Task>& tasks);
 void schrageWithHeap(std::vector<Task>& tasks);
 void ownAlgorithm(std::vector<Task>& tasks);
+bool loadEdgesFromFile(const std::string& filename, std::vector<Edge>& edges);
+bool adjustHeadsAndTails(std::vector<Task>& tasks, const std::vector<Edge>& edges);
+bool schrageWithPrecedence(std::vector<Task>& tasks, const std::vector<Edge>& edges);
+int lbMaxTask(const std::vector<Task>& tasks);
+int lbTotalLoad(const std::vector<Task>& tasks);
+int lbPreemptive(const std::vector<Task>& tasks);
+int lbCriticalBlock(const std::vector<Task>& tasks);
+const std::vector<LowerBound>& lowerBounds();
+int cascadeLowerBound(const std::vector<Task>& tasks, int incumbent, int* levelsUsed = nullptr);
+void benchmarkLowerBounds(const std::vector<std::string>& files);
+void dominanceEdges(const std::vector<Task>& tasks, std::vector<Edge>& edges);
+void decomposeInstance(const std::vector<Task>& tasks, std::vector<std::vector<Task> >& blocks);
+int solveDecomposed(std::vector<Task>& tasks, void (*solver)(std::vector<Task>&), int numThreads);
+int parallelTempering(std::vector<Task>& tasks, int timeBudgetMs, int numThreads);
+void batchSchrage(std::vector<std::vector<Task> >& instances, std::vector<int>& cmax);
 
 
 #endif // ALGORITHMS_HPP
\ No newline at end of file
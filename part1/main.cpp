@@ -14,6 +14,39 @@
         std::string inputFile = argv[1];
         std::string algorithm = argv[2];
 
+        if (algorithm[0] == 'l') {
+            std::vector<std::string> files;
+            files.push_back(inputFile);
+            for (int i = 3; i < argc; ++i) {
+                files.push_back(argv[i]);
+            }
+            benchmarkLowerBounds(files);
+            return 0;
+        }
+
+        if (algorithm[0] == 'b') {
+            std::vector<std::vector<Task> > instances(1);
+            loadTasksFromFile(inputFile, instances[0]);
+            for (int i = 3; i < argc; ++i) {
+                instances.push_back(std::vector<Task>());
+                loadTasksFromFile(argv[i], instances.back());
+            }
+            std::vector<int> results;
+            auto start = std::chrono::high_resolution_clock::now();
+            batchSchrage(instances, results);
+            auto end = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> batchTime = end - start;
+
+            long long total = 0;
+            for (int value : results) {
+                total += value;
+            }
+            std::cout << "Instances: " << instances.size() << ", Sum of Cmax: " << total << "\n";
+            std::cout << "Execution time: " << std::chrono::duration_cast<std::chrono::nanoseconds>(batchTime).count() << " ns\n";
+            std::cout << "Instances/s: " << instances.size() / batchTime.count() << "\n";
+            return 0;
+        }
+
         std::vector<Task> tasks;
         int cmax = 0;
 
@@ -70,6 +103,47 @@
                 elapsed = end - start;
                 break;
             }
+            case 'd':
+            {
+                int numThreads = std::max(1u, std::thread::hardware_concurrency());
+                auto start = std::chrono::high_resolution_clock::now();
+                int blocks = solveDecomposed(tasks, findOptimalTaskOrder, numThreads);
+                auto end = std::chrono::high_resolution_clock::now();
+                elapsed = end - start;
+                std::cout << "Sub-instances: " << blocks << "\n";
+                break;
+            }
+            case 't':
+            {
+                int timeBudgetMs = (argc > 3) ? std::stoi(argv[3]) : 1000;
+                int numThreads = std::max(1u, std::thread::hardware_concurrency());
+                auto start = std::chrono::high_resolution_clock::now();
+                int epochs = parallelTempering(tasks, timeBudgetMs, numThreads);
+                auto end = std::chrono::high_resolution_clock::now();
+                elapsed = end - start;
+                std::cout << "Epochs: " << epochs << "\n";
+                break;
+            }
+            case 'p':
+            {
+                if (argc < 4) {
+                    std::cerr << "Usage: " << argv[0] << " <input_file> p <edges_file>\n";
+                    return 1;
+                }
+                std::vector<Edge> edges;
+                if (!loadEdgesFromFile(argv[3], edges)) {
+                    return 1;
+                }
+                auto start = std::chrono::high_resolution_clock::now();
+                bool scheduled = schrageWithPrecedence(tasks, edges);
+                auto end = std::chrono::high_resolution_clock::now();
+                elapsed = end - start;
+                if (!scheduled) {
+                    std::cerr << "Error: No schedule for the given precedence graph\n";
+                    return 1;
+                }
+                break;
+            }
 
 
         
@@ -1,5 +1,10 @@
 #include "algorithms.hpp"
 #include <cmath>
+#include <cstdint>
+#include <numeric>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 // Wczytuje zadania z pliku tekstowego do wektora tasks. Każdy wiersz pliku
 // zawiera czas trwania zadania. Format pliku: pierwsza liczba to liczba zadań,
@@ -47,8 +52,8 @@ void sortTasks(std::vector<Task> &tasks) {
 }
 
 // Zwraca największy Cmax spośród wszystkich maszyn (czyli makespan).
-int calculateCmax(const std::vector<Machine> &machines) {
-  int currentTime = 0;
+long long calculateCmax(const std::vector<Machine> &machines) {
+  long long currentTime = 0;
   for (int i = 0; i < machines.size(); i++) {
     if (machines[i].Cmax > currentTime) {
       currentTime = machines[i].Cmax;
@@ -67,162 +72,769 @@ void printMachines(const std::vector<Machine> &machines) {
   }
 }
 
+LoadHeap::LoadHeap(const std::vector<long long> &loads, bool maxHeap)
+    : heap(loads.size()), pos(loads.size()), load(loads), maxHeap(maxHeap) {
+  for (size_t i = 0; i < loads.size(); ++i) {
+    heap[i] = i;
+    pos[i] = i;
+  }
+  for (int i = (int)heap.size() / 2 - 1; i >= 0; --i)
+    siftDown(i);
+}
+
+// Czy maszyna a powinna być bliżej korzenia niż maszyna b.
+bool LoadHeap::before(int a, int b) const {
+  if (load[a] != load[b])
+    return maxHeap ? load[a] > load[b] : load[a] < load[b];
+  return a < b;
+}
+
+void LoadHeap::siftUp(int i) {
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!before(heap[i], heap[parent]))
+      break;
+    std::swap(heap[i], heap[parent]);
+    pos[heap[i]] = i;
+    pos[heap[parent]] = parent;
+    i = parent;
+  }
+}
+
+void LoadHeap::siftDown(int i) {
+  int size = heap.size();
+  while (true) {
+    int best = i;
+    int left = 2 * i + 1, right = 2 * i + 2;
+    if (left < size && before(heap[left], heap[best]))
+      best = left;
+    if (right < size && before(heap[right], heap[best]))
+      best = right;
+    if (best == i)
+      break;
+    std::swap(heap[i], heap[best]);
+    pos[heap[i]] = i;
+    pos[heap[best]] = best;
+    i = best;
+  }
+}
+
+void LoadHeap::update(int machine, long long newLoad) {
+  load[machine] = newLoad;
+  siftUp(pos[machine]);
+  siftDown(pos[machine]);
+}
+
+// Widoki list zadań maszyn (sortowanie przez zliczanie): zadania maszyny k
+// to order[start[k]] .. order[start[k + 1] - 1], rosnąco wg indeksu.
+void Assignment::views(std::vector<int> &start,
+                       std::vector<int> &order) const {
+  int m = load.size();
+  start.assign(m + 1, 0);
+  for (int k : machineOf)
+    ++start[k + 1];
+  for (int k = 0; k < m; ++k)
+    start[k + 1] += start[k];
+  order.resize(machineOf.size());
+  std::vector<int> fill(start.begin(), start.end() - 1);
+  for (size_t j = 0; j < machineOf.size(); ++j)
+    order[fill[machineOf[j]]++] = j;
+}
+
+void Assignment::adopt(const std::vector<Task> &tasks,
+                       std::vector<int> machineOf) {
+  this->machineOf.swap(machineOf);
+  std::fill(load.begin(), load.end(), 0);
+  for (size_t j = 0; j < tasks.size(); ++j)
+    load[this->machineOf[j]] += tasks[j].pj;
+}
+
+// Zamienia płaski przydział na listy zadań maszyn - tylko na żądanie, np.
+// do wypisania harmonogramu (jedyne miejsce, w którym zadania są kopiowane).
+void applyAssignment(const std::vector<Task> &tasks, const Assignment &result,
+                     std::vector<Machine> &machines) {
+  createMachines(machines, result.load.size());
+  std::vector<int> start, order;
+  result.views(start, order);
+  for (size_t k = 0; k < machines.size(); ++k) {
+    auto &list = machines[k].tasksToDo;
+    list.clear();
+    list.reserve(start[k + 1] - start[k]);
+    for (int i = start[k]; i < start[k + 1]; ++i)
+      list.push_back(tasks[order[i]]);
+    machines[k].Cmax = result.load[k];
+  }
+}
+
+// Przydziela zadania tasks[begin..] w podanej kolejności, każde do maszyny o
+// najmniejszym obciążeniu (kopiec obciążeń - O(n log m)).
+static void listSchedule(const std::vector<Task> &tasks, Assignment &result,
+                         size_t begin) {
+  LoadHeap heap(result.load);
+  for (size_t j = begin; j < tasks.size(); ++j) {
+    int k = heap.top();
+    result.assign(j, k, tasks[j].pj);
+    heap.update(k, result.load[k]);
+  }
+}
+
+// To samo od pustych maszyn.
+static void listSchedule(const std::vector<Task> &tasks, Assignment &result) {
+  result = Assignment(tasks.size(), result.load.size());
+  listSchedule(tasks, result, 0);
+}
+
 // Algorytm LPT (Longest Processing Time first):
 // Sortuje zadania malejąco wg pj, a następnie przydziela każde zadanie do
 // maszyny o najmniejszym aktualnym Cmax.
-void lpt(std::vector<Task> &tasks, std::vector<Machine> &machines) {
+void lpt(std::vector<Task> &tasks, Assignment &result) {
   sortTasks(tasks); // sortowanie zadań malejąco
+  listSchedule(tasks, result);
+}
 
-  for (const auto &task : tasks) {
-    int minCmax = std::numeric_limits<int>::max();
-    int minIndex = -1;
-
-    // Szukamy maszyny o najmniejszym Cmax
-    for (size_t i = 0; i < machines.size(); ++i) {
-      if (machines[i].Cmax < minCmax) {
-        minCmax = machines[i].Cmax;
-        minIndex = i;
+// Algorytm LSA (List Scheduling Algorithm, Graham):
+// Przydziela zadania w kolejności z listy, każde do najmniej obciążonej
+// maszyny.
+void lsa(std::vector<Task> &tasks, Assignment &result) {
+  listSchedule(tasks, result);
+}
+
+// Zbiór osiągalnych sum podzbiorów jako bitset w słowach 64-bitowych.
+// Dodanie zadania o czasie p to bits |= bits << p (przesunięcie całymi
+// słowami), przetwarzane od najwyższego słowa, więc można to robić w miejscu.
+static void addToBitset(uint64_t *bits, int words, int shift) {
+  const int wordShift = shift / 64;
+  const int bitShift = shift % 64;
+
+  int w = words - 1;
+#ifdef __AVX2__
+  // 4 słowa naraz; słowa źródłowe leżą niżej niż docelowe, więc odczyt
+  // przed zapisem w tej samej iteracji jest bezpieczny.
+  const __m128i left = _mm_cvtsi32_si128(bitShift);
+  const __m128i right = _mm_cvtsi32_si128(64 - bitShift);
+  for (; w - 4 - wordShift >= 0; w -= 4) {
+    const uint64_t *src = &bits[w - 3 - wordShift];
+    __m256i high = _mm256_loadu_si256((const __m256i *)src);
+    __m256i low = _mm256_loadu_si256((const __m256i *)(src - 1));
+    __m256i shifted = _mm256_or_si256(_mm256_sll_epi64(high, left),
+                                      _mm256_srl_epi64(low, right));
+    __m256i *dst = (__m256i *)&bits[w - 3];
+    _mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), shifted));
+  }
+#endif
+  for (; w >= wordShift; --w) {
+    uint64_t shifted = bits[w - wordShift] << bitShift;
+    if (bitShift > 0 && w - wordShift - 1 >= 0)
+      shifted |= bits[w - wordShift - 1] >> (64 - bitShift);
+    bits[w] |= shifted;
+  }
+}
+
+static void addToBitset(std::vector<uint64_t> &bits, int shift) {
+  addToBitset(bits.data(), bits.size(), shift);
+}
+
+// Odwrotność addToBitset: bits |= bits >> shift, od najniższego słowa.
+static void subtractFromBitset(uint64_t *bits, int words, int shift) {
+  const int wordShift = shift / 64;
+  const int bitShift = shift % 64;
+  for (int w = 0; w + wordShift < words; ++w) {
+    uint64_t shifted = bits[w + wordShift] >> bitShift;
+    if (bitShift > 0 && w + wordShift + 1 < words)
+      shifted |= bits[w + wordShift + 1] << (64 - bitShift);
+    bits[w] |= shifted;
+  }
+}
+
+static bool testBit(const std::vector<uint64_t> &bits, long long s) {
+  return bits[s / 64] >> (s % 64) & 1;
+}
+
+// Bitset sum osiągalnych przez zadania weights[items[begin..end)], obcięty
+// do limit.
+static void reachableSums(const std::vector<int> &weights,
+                          const std::vector<int> &items, int begin, int end,
+                          long long limit, std::vector<uint64_t> &bits) {
+  const int words = limit / 64 + 1;
+  const uint64_t topMask = ~0ULL >> (63 - limit % 64);
+  bits.assign(words, 0);
+  bits[0] = 1;
+  for (int i = begin; i < end; ++i) {
+    if (weights[items[i]] > limit)
+      continue;
+    addToBitset(bits, weights[items[i]]);
+    bits[words - 1] &= topMask;
+  }
+}
+
+// Odtwarza podzbiór zadań weights[items[begin..end)] o sumie dokładnie target
+// (musi być osiągalna) metodą Hirschberga: dzieli zadania w połowie, szuka
+// rozkładu target = a + b na sumy osiągalne w obu połowach i schodzi
+// rekurencyjnie. Zadania dłuższe niż target są najpierw odrzucane. Poziom
+// rekursji kosztuje najwyżej tyle, co jedno DP, a głębokość to log n, więc
+// razem ok. 2x czas DP i pamięć 2 * target bitów zamiast tablic from/prev.
+static void findSubset(const std::vector<int> &weights, std::vector<int> &items,
+                       int begin, int end, long long target,
+                       std::vector<bool> &chosen) {
+  if (target == 0)
+    return;
+  end = std::partition(items.begin() + begin, items.begin() + end,
+                       [&](int i) { return weights[i] <= target; }) -
+        items.begin();
+  if (end - begin == 1) {
+    chosen[items[begin]] = true; // target == weights[items[begin]]
+    return;
+  }
+  int mid = begin + (end - begin) / 2;
+  long long sumA = 0, sumB = 0;
+  for (int i = begin; i < mid; ++i)
+    sumA += weights[items[i]];
+  for (int i = mid; i < end; ++i)
+    sumB += weights[items[i]];
+
+  long long targetA = -1;
+  {
+    std::vector<uint64_t> bitsA, bitsB;
+    reachableSums(weights, items, begin, mid, std::min(target, sumA), bitsA);
+    if (sumA >= target && testBit(bitsA, target))
+      targetA = target; // cały podzbiór w pierwszej połowie
+    else
+      reachableSums(weights, items, mid, end, std::min(target, sumB), bitsB);
+    for (long long a = std::min(target, sumA);
+         targetA < 0 && a >= std::max(0LL, target - sumB); --a) {
+      if (testBit(bitsA, a) && testBit(bitsB, target - a)) {
+        targetA = a;
+        break;
       }
     }
-
-    // Przydziel zadanie do wybranej maszyny
-    machines[minIndex].tasksToDo.push_back(task);
-    machines[minIndex].Cmax += task.pj;
   }
+  findSubset(weights, items, begin, mid, targetA, chosen);
+  findSubset(weights, items, mid, end, target - targetA, chosen);
 }
 
-// Algorytm LSA (List Scheduling Assignment):
-// Przydziela zadania do maszyn cyklicznie (round-robin).
-void lsa(std::vector<Task> &tasks, std::vector<Machine> &machines) {
-  for (size_t i = 0; i < tasks.size(); ++i) {
-    int machineIndex = i % machines.size(); // wybór maszyny cyklicznie
-    machines[machineIndex].tasksToDo.push_back(tasks[i]);
-    machines[machineIndex].Cmax += tasks[i].pj;
+// Wybiera podzbiór o największej sumie <= limit (zwraca tę sumę). Kończy DP,
+// gdy tylko osiągnie limit. Pamięć to około limit / 8 bajtów (dla podziału
+// na dwie maszyny: sum(p) / 16).
+static long long bestSubset(const std::vector<int> &weights, long long limit,
+                            std::vector<bool> &chosen) {
+  int n = weights.size();
+  chosen.assign(n, false);
+
+  const int words = limit / 64 + 1;
+  const uint64_t topMask = ~0ULL >> (63 - limit % 64);
+  long long best = limit;
+  int used = n; // podzbiór leży w weights[0..used)
+  {
+    std::vector<uint64_t> bits(words, 0);
+    bits[0] = 1;
+    for (int i = 0; i < n; ++i) {
+      if (weights[i] > limit)
+        continue;
+      addToBitset(bits, weights[i]);
+      bits[words - 1] &= topMask;
+      if (testBit(bits, limit)) {
+        used = i + 1;
+        break; // podział idealny
+      }
+    }
+    while (best > 0 && !testBit(bits, best))
+      --best;
   }
+
+  std::vector<int> items(used);
+  for (int i = 0; i < used; ++i)
+    items[i] = i;
+  findSubset(weights, items, 0, used, best, chosen);
+  return best;
 }
 
 // Algorytm Permutation-Dynamic (Partition Problem, DP) dla 2 maszyn:
 // Znajduje podział zadań na dwa zbiory o sumach jak najbardziej zbliżonych
-// (minimalizuje makespan).
-void pd(std::vector<Task> &tasks, std::vector<Machine> &machines) {
+// (minimalizuje makespan). DP po bitsecie, kończy się, gdy tylko znajdzie
+// podział idealny (suma total / 2). Zwraca false (bez harmonogramu) dla
+// m != 2.
+bool pd(std::vector<Task> &tasks, Assignment &result) {
   // Permutation-Dynamic (Partition Problem, DP) dla 2 maszyn
-  if (machines.size() != 2) {
+  if (result.load.size() != 2) {
     std::cerr << "PD (Permutation-Dynamic) implemented only for 2 machines!\n";
-    return;
+    return false;
   }
   int n = tasks.size();
-  int total = 0;
-  for (const auto &t : tasks)
-    total += t.pj;
-  int half = total / 2;
-
-  // dp[s] = true jeśli można uzyskać sumę s z pewnego podzbioru zadań
-  std::vector<bool> dp(half + 1, false);
-  std::vector<int> prev(half + 1, -1); // do odtworzenia podzbioru
-  std::vector<int> from(half + 1, -1);
-  dp[0] = true;
+  long long total = 0;
+  std::vector<int> weights(n);
   for (int i = 0; i < n; ++i) {
-    for (int s = half; s >= tasks[i].pj; --s) {
-      if (dp[s - tasks[i].pj] && !dp[s]) {
-        dp[s] = true;
-        prev[s] = s - tasks[i].pj;
-        from[s] = i;
-      }
-    }
+    weights[i] = tasks[i].pj;
+    total += tasks[i].pj;
   }
-  // znajdź największą możliwą sumę <= half
-  int best = half;
-  while (best >= 0 && !dp[best])
-    --best;
 
-  // Odtwórz podzbiór zadań dla maszyny 0
-  std::vector<bool> onMachine0(n, false);
-  int s = best;
-  while (s > 0) {
-    int i = from[s];
-    onMachine0[i] = true;
-    s = prev[s];
-  }
+  // Podzbiór zadań dla maszyny 0 o sumie możliwie bliskiej total / 2
+  std::vector<bool> onMachine0;
+  bestSubset(weights, total / 2, onMachine0);
+
   // Przydziel zadania do maszyn
-  for (int i = 0; i < n; ++i) {
-    if (onMachine0[i]) {
-      machines[0].tasksToDo.push_back(tasks[i]);
-      machines[0].Cmax += tasks[i].pj;
+  std::vector<int> machineOf(n);
+  for (int i = 0; i < n; ++i)
+    machineOf[i] = onMachine0[i] ? 0 : 1;
+  result.adopt(tasks, std::move(machineOf));
+  return true;
+}
+
+// Najmniejszy osiągalny cel Cmax w [lowerBound, upperBound), gdzie
+// upperBound jest osiągalny. feasible(target) zwraca Cmax znalezionego
+// rozwiązania (<= target) albo -1. Cele rosną od ograniczenia dolnego z
+// krokiem 1, 2, 4, ... (cele ciasne są dla przeszukiwania najłatwiejsze),
+// ale nigdy powyżej środka przedziału, więc prób jest O(log(UB - LB))
+// niezależnie od skali czasów pj.
+static long long searchTarget(
+    long long lowerBound, long long upperBound,
+    const std::function<long long(long long)> &feasible) {
+  long long step = 1;
+  while (lowerBound < upperBound) {
+    long long target = std::min(lowerBound + step - 1,
+                                lowerBound + (upperBound - lowerBound) / 2);
+    long long found = feasible(target);
+    if (found >= 0) {
+      upperBound = found;
     } else {
-      machines[1].tasksToDo.push_back(tasks[i]);
-      machines[1].Cmax += tasks[i].pj;
+      lowerBound = target + 1;
+      step *= 2;
     }
   }
+  return upperBound;
 }
 
-// Algorytm PTAS (Polynomial Time Approximation Scheme) dla 2 maszyn:
-// Optymalnie przydziela k największych zadań (przegląd wszystkich podziałów),
-// resztę przydziela zachłannie.
-void ptas(std::vector<Task> &tasks, std::vector<Machine> &machines) {
-  // PTAS dla problemu podziału zadań na 2 maszyny
-  if (machines.size() != 2) {
-    std::cerr << "PTAS implemented only for 2 machines!\n";
-    return;
+// Skrót posortowanego wektora obciążeń (klucz tablicy stanów bez poprawy).
+struct LoadsHash {
+  size_t operator()(const std::vector<int> &v) const {
+    uint64_t h = 1469598103934665603ull;
+    for (int x : v)
+      h = (h ^ (uint32_t)x) * 1099511628211ull;
+    return h;
+  }
+};
+
+// Dokładny przydział zadań o czasach p (posortowanych malejąco) do m maszyn
+// (DFS z ograniczeniami). Cel Cmax wybiera searchTarget między ograniczeniem
+// dolnym max(p_max, ceil(sum / m), p_m + p_m+1, goodEnough) a najlepszym
+// znanym rozwiązaniem (startowo LPT), więc DFS jest O(log(LPT - LB)).
+// Maszyny o równym obciążeniu są symetryczne, więc na każdym poziomie
+// próbujemy tylko jednej z nich. Gałąź odpada, gdy luki maszyn zapełnialne
+// sumami pozostałych zadań ich nie pomieszczą, a stany (poziom, posortowane
+// obciążenia) bez rozwiązania są zapamiętywane.
+// assign[j] - maszyna zadania j. nodeLimit > 0 ogranicza liczbę węzłów DFS;
+// po jego wyczerpaniu assign to najlepszy znaleziony przydział (co najmniej
+// LPT), a wynikiem jest false.
+static bool exactAssignment(const std::vector<int> &p, int m,
+                            std::vector<int> &assign, long long goodEnough = 0,
+                            long long nodeLimit = 0) {
+  int n = p.size();
+  assign.assign(n, 0);
+  if (n == 0)
+    return true;
+
+  std::vector<long long> remaining(n + 1, 0); // suma p[j..n)
+  for (int j = n - 1; j >= 0; --j)
+    remaining[j] = remaining[j + 1] + p[j];
+  long long lowerBound = std::max<long long>(
+      {(long long)p[0], (remaining[0] + m - 1) / m, goodEnough});
+  if (n > m) // któraś maszyna dostanie dwa z m + 1 największych zadań
+    lowerBound = std::max<long long>(lowerBound, p[m - 1] + p[m]);
+
+  // Rozwiązanie startowe: LPT
+  std::vector<long long> load(m, 0);
+  for (int j = 0; j < n; ++j) {
+    int k = std::min_element(load.begin(), load.end()) - load.begin();
+    assign[j] = k;
+    load[k] += p[j];
+  }
+  long long best = *std::max_element(load.begin(), load.end());
+
+  std::vector<int> current(n, 0);
+  std::fill(load.begin(), load.end(), 0);
+  // limit pamięci tablicy stanów; klucz to obciążenia jako int
+  const size_t maxFailed =
+      best <= std::numeric_limits<int>::max() ? 4000000 : 0;
+  std::unordered_set<std::vector<int>, LoadsHash> failed;
+  std::vector<int> key(m + 1);
+  long long target = 0;
+  long long nodes = 0;
+
+  // usable[j][g] - największa suma podzbioru zadań j..n-1 nie większa niż g,
+  // czyli ile luki g maszyny da się naprawdę zapełnić (dla małych sum)
+  std::vector<std::vector<int>> usable;
+  if ((long long)(n + 1) * (best + 1) <= 20000000) {
+    usable.assign(n + 1, std::vector<int>(best + 1, 0));
+    std::vector<char> reach(best + 1, 0);
+    reach[0] = 1;
+    for (int j = n - 1; j >= 0; --j) {
+      for (long long s = best; s >= p[j]; --s)
+        reach[s] |= reach[s - p[j]];
+      for (long long g = 1; g <= best; ++g)
+        usable[j][g] = reach[g] ? g : usable[j][g - 1];
+    }
   }
-  double epsilon = 0.2; // możesz zmienić dokładność
+
+  // Czy zadania j..n-1 mieszczą się na maszynach przy Cmax <= target
+  std::function<bool(int)> fits = [&](int j) {
+    if (j == n)
+      return true;
+    if (nodeLimit > 0 && ++nodes > nodeLimit)
+      return false; // budżet wyczerpany - przerwanie, bez zapamiętywania
+    long long space = 0;
+    for (int k = 0; k < m; ++k) {
+      long long gap = target - load[k];
+      if (!usable.empty())
+        space += usable[j][gap];
+      else if (gap >= p[n - 1])
+        space += gap;
+    }
+    if (space < remaining[j])
+      return false;
+
+    // Maszyny od najmniej obciążonej, każde obciążenie raz (symetria)
+    std::vector<int> order(m);
+    for (int k = 0; k < m; ++k)
+      order[k] = k;
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return load[a] < load[b]; });
+    for (int k = 0; k < m; ++k)
+      key[k] = load[order[k]];
+    key[m] = j;
+    if (failed.count(key))
+      return false;
+
+    for (int i = 0; i < m; ++i) {
+      int k = order[i];
+      if (i > 0 && load[k] == load[order[i - 1]])
+        continue;
+      if (load[k] + p[j] > target)
+        break; // kolejne maszyny są jeszcze bardziej obciążone
+      load[k] += p[j];
+      current[j] = k;
+      bool found = fits(j + 1);
+      load[k] -= p[j];
+      if (found)
+        return true;
+    }
+    if (failed.size() < maxFailed && (nodeLimit == 0 || nodes <= nodeLimit)) {
+      for (int k = 0; k < m; ++k)
+        key[k] = load[order[k]];
+      key[m] = j;
+      failed.insert(key);
+    }
+    return false;
+  };
+
+  searchTarget(lowerBound, best, [&](long long t) -> long long {
+    target = t;
+    failed.clear();
+    if (!fits(0))
+      return -1;
+    assign = current;
+    std::vector<long long> found(m, 0);
+    for (int j = 0; j < n; ++j)
+      found[assign[j]] += p[j];
+    return *std::max_element(found.begin(), found.end());
+  });
+  return nodeLimit == 0 || nodes <= nodeLimit;
+}
+
+// Najlepszy podział zadań p na 2 maszyny przez przegląd wszystkich masek
+// (bit i - zadanie i na maszynie 0). Ostatnie zadanie (bit k-1, przy
+// sortowaniu malejącym najkrótsze z k) zostaje na maszynie 1 (maska i jej
+// dopełnienie to ten sam podział), więc masek jest 2^(k-1).
+// Maski idą w kolejności kodu Graya - kolejna różni się jednym bitem, więc
+// suma zmienia się w O(1). Zakres jest dzielony między wątki, każdy zaczyna
+// od sumy liczonej wprost; kończą wszystkie po znalezieniu podziału
+// idealnego.
+static uint64_t bestTwoWaySplit(const std::vector<int> &p) {
+  int k = p.size();
+  if (k < 2)
+    return 0;
+  long long total = 0;
+  for (int x : p)
+    total += x;
+  uint64_t count = 1ull << (k - 1);
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  if (count < (1u << 16))
+    threads = 1;
+
+  std::vector<long long> bestCmax(threads,
+                                 std::numeric_limits<long long>::max());
+  std::vector<uint64_t> bestMask(threads, 0);
+  std::atomic<bool> perfect(false);
+  auto search = [&](int t) {
+    uint64_t begin = count * t / threads, end = count * (t + 1) / threads;
+    uint64_t mask = begin ^ (begin >> 1);
+    long long sum0 = 0;
+    for (int i = 0; i < k - 1; ++i)
+      if (mask >> i & 1)
+        sum0 += p[i];
+    for (uint64_t g = begin; g < end; ++g) {
+      if (g != begin) { // zmienia się bit najmłodszej jedynki g
+        int bit = __builtin_ctzll(g);
+        mask ^= 1ull << bit;
+        sum0 += (mask >> bit & 1) ? p[bit] : -p[bit];
+      }
+      long long cmax = std::max(sum0, total - sum0);
+      if (cmax < bestCmax[t]) {
+        bestCmax[t] = cmax;
+        bestMask[t] = mask;
+        if (cmax - (total - cmax) <= 1) {
+          perfect = true;
+          break;
+        }
+      }
+      if ((g & 0xFFFF) == 0 && perfect)
+        break;
+    }
+  };
+  std::vector<std::thread> pool;
+  for (int t = 1; t < threads; ++t)
+    pool.emplace_back(search, t);
+  search(0);
+  for (auto &thread : pool)
+    thread.join();
+
+  int best = std::min_element(bestCmax.begin(), bestCmax.end()) -
+             bestCmax.begin();
+  return bestMask[best];
+}
+
+// Algorytm PTAS (Polynomial Time Approximation Scheme) dla m maszyn (Graham):
+// Optymalnie przydziela k największych zadań, resztę przydziela zachłannie
+// (LPT). Daje Cmax <= rho * OPT, rho = 1 + (1 - 1/m) / (1 + floor(k/m)), więc
+// k jest dobierane tak, żeby rho <= 1 + epsilon (i nie mniej niż 2/epsilon,
+// jak dotychczas dla 2 maszyn). Zwraca rho albo gwarancję LPT, jeśli
+// przydział k największych zadań nie zmieścił się w budżecie węzłów.
+double ptas(std::vector<Task> &tasks, Assignment &result, double epsilon) {
   int n = tasks.size();
-  int k = static_cast<int>(std::ceil(
-      2.0 / epsilon)); // liczba największych zadań do optymalnego przydziału
+  int m = result.load.size();
+  int k = m * std::max(0, (int)std::ceil((1.0 - 1.0 / m) / epsilon - 1.0));
+  k = std::max(k, (int)std::ceil(2.0 / epsilon));
+  if (m == 2 && k > 34)
+    k = 34; // 2^33 kroków kodu Graya
+  double guarantee = 1.0 + (1.0 - 1.0 / m) / (1 + k / m);
   if (k > n)
     k = n;
 
-  // Sortuj zadania malejąco wg pj
-  std::vector<Task> sortedTasks = tasks;
-  std::sort(sortedTasks.begin(), sortedTasks.end(),
-            [](const Task &a, const Task &b) { return a.pj > b.pj; });
+  sortTasks(tasks); // sortowanie zadań malejąco
 
-  // Wygeneruj wszystkie możliwe podziały k największych zadań (2^k podziałów)
-  int bestCmax = std::numeric_limits<int>::max();
   std::vector<int> bestAssign(k, 0);
-  for (int mask = 0; mask < (1 << k); ++mask) {
-    int sum0 = 0, sum1 = 0;
-    for (int i = 0; i < k; ++i) {
-      if (mask & (1 << i))
-        sum0 += sortedTasks[i].pj;
-      else
-        sum1 += sortedTasks[i].pj;
-    }
-    int cmax = std::max(sum0, sum1);
-    if (cmax < bestCmax) {
-      bestCmax = cmax;
-      for (int i = 0; i < k; ++i)
-        bestAssign[i] = (mask & (1 << i)) ? 0 : 1;
-    }
+  if (m == 2) {
+    std::vector<int> largest(k);
+    for (int i = 0; i < k; ++i)
+      largest[i] = tasks[i].pj;
+    uint64_t mask = bestTwoWaySplit(largest);
+    for (int i = 0; i < k; ++i)
+      bestAssign[i] = (mask >> i & 1) ? 0 : 1;
+  } else {
+    // Gwarancja wymaga tylko Cmax(k największych) <= rho * OPT, więc
+    // wystarczy zejść do rho * (ograniczenie dolne całej instancji).
+    long long total = 0;
+    for (const auto &t : tasks)
+      total += t.pj;
+    long long lowerBound =
+        n > 0 ? std::max<long long>(tasks[0].pj, (total + m - 1) / m) : 0;
+    if (n > m)
+      lowerBound = std::max<long long>(
+          lowerBound, tasks[m - 1].pj + tasks[m].pj);
+    std::vector<int> largest(k);
+    for (int i = 0; i < k; ++i)
+      largest[i] = tasks[i].pj;
+    // Dla k bliskiego n to już pełne przeszukiwanie dokładne - po
+    // wyczerpaniu budżetu zostaje LPT na k największych (lub lepszy
+    // znaleziony przydział), a gwarancja spada do gwarancji LPT.
+    const long long nodeLimit = 1000000;
+    if (!exactAssignment(largest, m, bestAssign,
+                         (long long)(guarantee * lowerBound), nodeLimit))
+      guarantee = std::max(guarantee, 4.0 / 3.0 - 1.0 / (3.0 * m));
   }
+
   // Przydziel k największych zadań zgodnie z najlepszym podziałem
-  machines[0].tasksToDo.clear();
-  machines[0].Cmax = 0;
-  machines[1].tasksToDo.clear();
-  machines[1].Cmax = 0;
-  for (int i = 0; i < k; ++i) {
-    machines[bestAssign[i]].tasksToDo.push_back(sortedTasks[i]);
-    machines[bestAssign[i]].Cmax += sortedTasks[i].pj;
-  }
+  result = Assignment(n, m);
+  for (int i = 0; i < k; ++i)
+    result.assign(i, bestAssign[i], tasks[i].pj);
   // Pozostałe zadania przydziel zachłannie do najmniej obciążonej maszyny
-  for (int i = k; i < n; ++i) {
-    int idx = (machines[0].Cmax < machines[1].Cmax) ? 0 : 1;
-    machines[idx].tasksToDo.push_back(sortedTasks[i]);
-    machines[idx].Cmax += sortedTasks[i].pj;
-  }
+  listSchedule(tasks, result, k);
+
+  if (m == 2 && k == n)
+    return 1.0; // pełny przegląd wszystkich podziałów
+  return guarantee;
 }
 
-// Algorytm FPTAS (Fully Polynomial Time Approximation Scheme) dla 2 maszyn:
-// Zeskalowuje czasy zadań, rozwiązuje problem podziału dynamicznie na
-// zeskalowanych danych, odtwarza przydział.
-void fptas(std::vector<Task> &tasks, std::vector<Machine> &machines) {
-  // FPTAS dla problemu podziału zadań na 2 maszyny
-  if (machines.size() != 2) {
-    std::cerr << "FPTAS implemented only for 2 machines!\n";
-    return;
+// Zużycie zasobów przez listy stanów FPTAS (do benchmarku).
+struct FptasStats {
+  size_t peakStates = 0; // największa lista stanów po przycięciu
+  size_t peakBytes = 0;  // szczytowa pamięć list i śladów odtwarzania
+};
+
+// FPTAS Sahniego dla stałego m: stan to wektor obciążeń maszyn posortowany
+// malejąco (maszyny są symetryczne), lista stanów to płaska tablica
+// count * m. Po każdym zadaniu (w kolejności LPT) stany o tych samych
+// kubełkach floor(obciążenie / delta), delta = epsilon * LB / n, są sobie
+// równoważne - zostaje ten o najmniejszym Cmax (suma obciążeń jest po
+// każdym zadaniu taka sama, więc to jedyna sensowna dominacja). Każde
+// przycięcie przesuwa obciążenia o mniej niż delta, więc wynik
+// <= OPT + n * delta <= (1 + epsilon) * OPT. Stany z Cmax powyżej LPT
+// są odrzucane od razu. assign[j] - maszyna zadania j (po sortowaniu).
+// Liczba stanów rośnie jak (n / epsilon)^(m-1) - po przekroczeniu limitu
+// stanów na warstwę albo pamięci śladów zwraca false (bez przydziału).
+static bool fptasStates(std::vector<Task> &tasks, int m, double epsilon,
+                        std::vector<int> &assign, FptasStats *stats = nullptr) {
+  sortTasks(tasks);
+  int n = tasks.size();
+  assign.assign(n, 0);
+  if (n == 0)
+    return true;
+
+  // Ograniczenia: dolne max(p_max, ceil(sum / m)), górne z LPT
+  long long total = 0;
+  for (const auto &t : tasks)
+    total += t.pj;
+  long long lowerBound = std::max<long long>(tasks[0].pj, (total + m - 1) / m);
+  std::vector<int> lptAssign(n);
+  long long upperBound = 0;
+  {
+    LoadHeap heap(std::vector<long long>(m, 0));
+    for (int j = 0; j < n; ++j) {
+      int k = heap.top();
+      lptAssign[j] = k;
+      heap.update(k, heap.load[k] + tasks[j].pj);
+      upperBound = std::max(upperBound, heap.load[k]);
+    }
+  }
+  long long delta =
+      std::max<long long>(1, (long long)(epsilon * lowerBound / n));
+
+  std::vector<long long> cur(m, 0); // jeden stan startowy: same zera
+  std::vector<long long> next, keys;
+  std::vector<int> nextParent, order;
+  std::vector<uint8_t> nextWhere;
+  std::vector<std::vector<int>> parent(n);    // stan poprzedni
+  std::vector<std::vector<uint8_t>> where(n); // pozycja maszyny w stanie
+  size_t traceBytes = 0;
+  const size_t maxStates = 200000;          // ok. 1 s dla n = 50, m = 3
+  const size_t maxTraceBytes = 256u << 20; // ślady parent/where
+
+  for (int j = 0; j < n; ++j) {
+    int p = tasks[j].pj;
+    size_t count = cur.size() / m;
+    next.clear();
+    nextParent.clear();
+    nextWhere.clear();
+    for (size_t s = 0; s < count; ++s) {
+      const long long *load = &cur[s * m];
+      for (int k = 0; k < m; ++k) {
+        if (k > 0 && load[k] == load[k - 1])
+          continue; // symetria
+        if (load[k] + p > upperBound)
+          continue;
+        size_t at = next.size();
+        next.insert(next.end(), load, load + m);
+        long long *child = &next[at];
+        child[k] += p;
+        for (int i = k; i > 0 && child[i] > child[i - 1]; --i)
+          std::swap(child[i], child[i - 1]);
+        nextParent.push_back(s);
+        nextWhere.push_back(k);
+      }
+    }
+    if (next.empty()) { // wszystko odcięte - zostaje LPT
+      assign = lptAssign;
+      return true;
+    }
+
+    // Sortowanie po kubełkach, w grupie najpierw najmniejszy Cmax
+    size_t children = nextParent.size();
+    keys.resize(next.size());
+    for (size_t i = 0; i < next.size(); ++i)
+      keys[i] = next[i] / delta;
+    order.resize(children);
+    for (size_t i = 0; i < children; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+      for (int i = 0; i < m; ++i)
+        if (keys[(size_t)a * m + i] != keys[(size_t)b * m + i])
+          return keys[(size_t)a * m + i] < keys[(size_t)b * m + i];
+      return next[(size_t)a * m] < next[(size_t)b * m];
+    });
+
+    cur.clear();
+    for (size_t i = 0; i < children; ++i) {
+      size_t a = order[i];
+      if (i > 0 && std::equal(&keys[a * m], &keys[a * m] + m,
+                              &keys[(size_t)order[i - 1] * m]))
+        continue;
+      cur.insert(cur.end(), &next[a * m], &next[a * m] + m);
+      parent[j].push_back(nextParent[a]);
+      where[j].push_back(nextWhere[a]);
+    }
+
+    traceBytes += parent[j].size() * (sizeof(int) + sizeof(uint8_t));
+    if (parent[j].size() > maxStates || traceBytes > maxTraceBytes)
+      return false;
+    if (stats) {
+      stats->peakStates = std::max(stats->peakStates, cur.size() / m);
+      size_t bytes =
+          (cur.capacity() + next.capacity() + keys.capacity()) *
+              sizeof(long long) +
+          (order.capacity() + nextParent.capacity()) * sizeof(int) +
+          nextWhere.capacity() + traceBytes;
+      stats->peakBytes = std::max(stats->peakBytes, bytes);
+    }
+  }
+
+  // Najlepszy stan końcowy, ślad wstecz do stanu startowego
+  size_t count = cur.size() / m;
+  size_t best = 0;
+  for (size_t s = 1; s < count; ++s)
+    if (cur[s * m] < cur[best * m])
+      best = s;
+  std::vector<int> chain(n);
+  chain[n - 1] = best;
+  for (int j = n - 1; j > 0; --j)
+    chain[j - 1] = parent[j][chain[j]];
+
+  // Odtworzenie: te same przestawienia co przy generowaniu stanów,
+  // machineAt[i] - maszyna na pozycji i posortowanego wektora
+  std::vector<long long> load(m, 0);
+  std::vector<int> machineAt(m);
+  for (int i = 0; i < m; ++i)
+    machineAt[i] = i;
+  for (int j = 0; j < n; ++j) {
+    int k = where[j][chain[j]];
+    assign[j] = machineAt[k];
+    load[k] += tasks[j].pj;
+    for (int i = k; i > 0 && load[i] > load[i - 1]; --i) {
+      std::swap(load[i], load[i - 1]);
+      std::swap(machineAt[i], machineAt[i - 1]);
+    }
   }
-  double epsilon = 0.2; // możesz zmienić dokładność
+  return true;
+}
+
+// Algorytm FPTAS (Fully Polynomial Time Approximation Scheme):
+// Dla 2 maszyn zeskalowuje czasy zadań, rozwiązuje problem podziału
+// dynamicznie na zeskalowanych danych i odtwarza przydział. Dla m > 2
+// używa przycinanych list stanów (fptasStates) i zwraca false (bez
+// harmonogramu), gdy lista stanów przekroczy limit.
+bool fptas(std::vector<Task> &tasks, Assignment &result, double epsilon) {
   int n = tasks.size();
-  int total = 0;
+  int m = result.load.size();
+  if (m > 2) {
+    std::vector<int> assign;
+    if (!fptasStates(tasks, m, epsilon, assign))
+      return false;
+    result.adopt(tasks, std::move(assign));
+    return true;
+  }
+  if (m < 2) {
+    listSchedule(tasks, result);
+    return true;
+  }
+
+  long long total = 0;
   for (const auto &t : tasks)
     total += t.pj;
   int K = (int)(epsilon * total / (2 * n));
@@ -235,89 +847,1388 @@ void fptas(std::vector<Task> &tasks, std::vector<Machine> &machines) {
   int scaledSum = 0;
   for (int v : scaled)
     scaledSum += v;
-  int half = scaledSum / 2;
   // DP na zeskalowanych danych (Subset Sum)
-  std::vector<bool> dp(half + 1, false);
-  std::vector<int> prev(half + 1, -1);
-  std::vector<int> from(half + 1, -1);
-  dp[0] = true;
-  for (int i = 0; i < n; ++i) {
-    for (int s = half; s >= scaled[i]; --s) {
-      if (dp[s - scaled[i]] && !dp[s]) {
-        dp[s] = true;
-        prev[s] = s - scaled[i];
-        from[s] = i;
+  std::vector<bool> onMachine0;
+  bestSubset(scaled, scaledSum / 2, onMachine0);
+  // Przydziel zadania do maszyn zgodnie z wynikiem DP
+  std::vector<int> machineOf(n);
+  for (int i = 0; i < n; ++i)
+    machineOf[i] = onMachine0[i] ? 0 : 1;
+  result.adopt(tasks, std::move(machineOf));
+  return true;
+}
+
+// Pomiar czasu i pamięci FPTAS z listami stanów dla m = 2..5 i rosnącego
+// 1/epsilon na jednej instancji. Liczba stanów rośnie jak (n / epsilon)^(m-1),
+// więc po przebiegu dłuższym niż sekunda albo po przekroczeniu limitu stanów
+// kolejne 1/epsilon są pomijane.
+void benchmarkFptas(const std::vector<Task> &tasks) {
+  std::cout << "m  1/eps  Cmax  States  Memory [KB]  Time [ms]\n";
+  for (int m = 2; m <= 5; ++m) {
+    bool skip = false;
+    for (int inverse : {2, 5, 10, 20, 50}) {
+      if (skip) {
+        std::cout << m << "  " << inverse << "  skipped" << std::endl;
+        continue;
       }
+      std::vector<Task> copy = tasks;
+      std::vector<int> assign;
+      FptasStats stats;
+      auto start = std::chrono::high_resolution_clock::now();
+      bool finished = fptasStates(copy, m, 1.0 / inverse, assign, &stats);
+      auto end = std::chrono::high_resolution_clock::now();
+      if (!finished) {
+        std::cout << m << "  " << inverse << "  state limit" << std::endl;
+        skip = true;
+        continue;
+      }
+      std::vector<long long> load(m, 0);
+      for (size_t i = 0; i < copy.size(); ++i)
+        load[assign[i]] += copy[i].pj;
+      double ms =
+          std::chrono::duration<double, std::milli>(end - start).count();
+      skip = ms > 1000;
+      std::cout << m << "  " << inverse << "  "
+                << *std::max_element(load.begin(), load.end()) << "  "
+                << stats.peakStates << "  " << stats.peakBytes / 1024 << "  "
+                << ms << std::endl;
     }
   }
-  int best = half;
-  while (best >= 0 && !dp[best])
-    --best;
-  std::vector<bool> onMachine0(n, false);
-  int s = best;
-  while (s > 0) {
-    int i = from[s];
-    onMachine0[i] = true;
-    s = prev[s];
+}
+
+// Algorytm optymalny (podział i ograniczenia, exactAssignment):
+// Szuka celu Cmax między ograniczeniem dolnym max(p_max, ceil(sum / m),
+// p_m + p_m+1) a LPT (searchTarget); dla każdego celu DFS w kolejności LPT
+// sprawdza, czy zadania się mieszczą, pomijając maszyny o równym obciążeniu
+// (symetria). Zwraca false (bez harmonogramu), gdy przeszukiwanie nie
+// zmieści się w budżecie węzłów - wynik nie byłby udowodnionym optimum.
+bool opt(std::vector<Task> &tasks, Assignment &result) {
+  sortTasks(tasks); // sortowanie zadań malejąco
+  int n = tasks.size();
+  std::vector<int> p(n), assign;
+  for (int i = 0; i < n; ++i)
+    p[i] = tasks[i].pj;
+  const long long nodeLimit = 3000000; // do kilku sekund
+  if (!exactAssignment(p, result.load.size(), assign, 0, nodeLimit))
+    return false;
+  result.adopt(tasks, std::move(assign));
+  return true;
+}
+
+// Algorytm dokładny (DP po podzbiorach) dla n <= 24 zadań:
+// Dla zadanego celu C traktuje maszyny jak kolejno zapełniane pojemniki.
+// Stan podzbioru zadań mask to najmniejsza para (liczba maszyn, zapełnienie
+// ostatniej), spakowana w jedno słowo 32-bitowe. Cel jest szukany
+// bisekcją po osiągalnych sumach podzbiorów z przedziału
+// [ograniczenie dolne, LPT] - Cmax optimum jest jedną z nich. Zwraca false
+// (bez harmonogramu) dla n > 24 albo sumy pj >= 2^27.
+bool subsetDp(std::vector<Task> &tasks, Assignment &result) {
+  int n = tasks.size();
+  int m = result.load.size();
+  if (n > 24) {
+    std::cerr << "SDP (Subset DP) implemented only for up to 24 tasks!\n";
+    return false;
   }
-  // Przydziel zadania do maszyn zgodnie z wynikiem DP
-  machines[0].tasksToDo.clear();
-  machines[0].Cmax = 0;
-  machines[1].tasksToDo.clear();
-  machines[1].Cmax = 0;
-  for (int i = 0; i < n; ++i) {
-    if (onMachine0[i]) {
-      machines[0].tasksToDo.push_back(tasks[i]);
-      machines[0].Cmax += tasks[i].pj;
+  const int fillBits = 27; // 5 bitów na liczbę maszyn (<= 24 + 1)
+  long long total = 0;
+  for (const auto &t : tasks)
+    total += t.pj;
+  if (total >= (1LL << fillBits)) {
+    std::cerr << "SDP (Subset DP) requires sum of pj below 2^27!\n";
+    return false;
+  }
+  if (n == 0)
+    return true;
+
+  // Sumy wszystkich podzbiorów
+  uint32_t full = (1u << n) - 1;
+  std::vector<uint32_t> sum(full + 1, 0);
+  for (uint32_t mask = 1; mask <= full; ++mask)
+    sum[mask] = sum[mask & (mask - 1)] + tasks[__builtin_ctz(mask)].pj;
+
+  // Ograniczenia: dolne max(p_max, ceil(sum / m)), górne z LPT
+  std::vector<Task> sorted = tasks;
+  sortTasks(sorted);
+  long long lowerBound =
+      std::max<long long>(sorted[0].pj, (total + m - 1) / m);
+  std::vector<long long> lptLoad(m, 0);
+  for (const auto &t : sorted)
+    *std::min_element(lptLoad.begin(), lptLoad.end()) += t.pj;
+  long long upperBound = *std::max_element(lptLoad.begin(), lptLoad.end());
+
+  // Kandydaci na Cmax: osiągalne sumy z [lowerBound, upperBound]
+  std::vector<bool> reachable(upperBound - lowerBound + 1, false);
+  for (uint32_t mask = 0; mask <= full; ++mask)
+    if (sum[mask] >= lowerBound && sum[mask] <= upperBound)
+      reachable[sum[mask] - lowerBound] = true;
+  std::vector<long long> candidates;
+  for (size_t i = 0; i < reachable.size(); ++i)
+    if (reachable[i])
+      candidates.push_back(lowerBound + i);
+
+  const uint32_t fillMask = (1u << fillBits) - 1;
+  std::vector<uint32_t> state(full + 1);
+  auto extend = [&](uint32_t s, uint32_t p, uint32_t capacity) {
+    if ((s & fillMask) + p <= capacity)
+      return s + p;                            // ta sama maszyna
+    return ((s >> fillBits) + 1) << fillBits | p; // następna maszyna
+  };
+  // Czy zadania mieszczą się na m maszynach przy Cmax <= capacity
+  auto feasible = [&](uint32_t capacity) {
+    state[0] = 1u << fillBits; // pierwsza maszyna, puste zapełnienie
+    for (uint32_t mask = 1; mask <= full; ++mask) {
+      uint32_t best = std::numeric_limits<uint32_t>::max();
+      for (uint32_t rest = mask; rest; rest &= rest - 1) {
+        int i = __builtin_ctz(rest);
+        best = std::min(best, extend(state[mask ^ (1u << i)], tasks[i].pj,
+                                     capacity));
+      }
+      state[mask] = best;
+    }
+    return (int)(state[full] >> fillBits) <= m;
+  };
+
+  // Bisekcja: upperBound (wynik LPT) jest zawsze osiągalny
+  size_t lo = 0, hi = candidates.size() - 1;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (feasible(candidates[mid]))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  uint32_t capacity = candidates[lo];
+  feasible(capacity);
+
+  // Odtworzenie: zdejmuj zadanie, które dało stan podzbioru
+  std::vector<int> machineOf(n);
+  for (uint32_t mask = full; mask;) {
+    for (uint32_t rest = mask; rest; rest &= rest - 1) {
+      int i = __builtin_ctz(rest);
+      uint32_t prev = mask ^ (1u << i);
+      if (extend(state[prev], tasks[i].pj, capacity) == state[mask]) {
+        machineOf[i] = (state[mask] >> fillBits) - 1;
+        mask = prev;
+        break;
+      }
+    }
+  }
+  result.adopt(tasks, std::move(machineOf));
+  return true;
+}
+
+// First Fit Decreasing dla zadań posortowanych malejąco i m pojemników
+// (maszyn) o pojemności capacity. Wolne miejsca maszyn trzyma drzewo
+// przedziałowe maksimów, więc pierwszą pasującą maszynę znajduje zejście
+// od korzenia w O(log m). Zwraca false, gdy któreś zadanie się nie mieści.
+static bool firstFitDecreasing(const std::vector<Task> &sorted, int m,
+                               long long capacity, std::vector<int> &assign) {
+  int size = 1;
+  while (size < m)
+    size *= 2;
+  std::vector<long long> tree(2 * size, -1); // liście poza m: brak maszyny
+  for (int k = 0; k < m; ++k)
+    tree[size + k] = capacity;
+  for (int i = size - 1; i > 0; --i)
+    tree[i] = std::max(tree[2 * i], tree[2 * i + 1]);
+
+  assign.resize(sorted.size());
+  for (size_t j = 0; j < sorted.size(); ++j) {
+    int p = sorted[j].pj;
+    if (tree[1] < p)
+      return false;
+    int node = 1;
+    while (node < size) // najbardziej na lewo poddrzewo z miejscem >= p
+      node = tree[2 * node] >= p ? 2 * node : 2 * node + 1;
+    assign[j] = node - size;
+    tree[node] -= p;
+    for (node /= 2; node > 0; node /= 2)
+      tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+  }
+  return true;
+}
+
+// Algorytm MULTIFIT (Coffman, Garey, Johnson):
+// Bisekcja po pojemności C maszyn w przedziale
+// [max(p_max, sum / m), max(p_max, 2 * sum / m)], sprawdzając FFD, czy
+// zadania mieszczą się na m maszynach. Zadania są sortowane raz, a wynik to
+// przydział FFD dla najmniejszego znalezionego C (gwarancja 13/11 * OPT).
+void multifit(std::vector<Task> &tasks, Assignment &result) {
+  sortTasks(tasks); // sortowanie zadań malejąco
+  int m = result.load.size();
+  long long total = 0;
+  for (const auto &t : tasks)
+    total += t.pj;
+  long long pmax = tasks.empty() ? 0 : tasks[0].pj;
+  long long lo = std::max(pmax, (total + m - 1) / m);
+  long long hi = std::max(pmax, (2 * total + m - 1) / m);
+
+  std::vector<int> assign, bestAssign;
+  firstFitDecreasing(tasks, m, hi, bestAssign); // przy 2 * sum / m zawsze
+  while (lo < hi) {
+    long long mid = lo + (hi - lo) / 2;
+    if (firstFitDecreasing(tasks, m, mid, assign)) {
+      hi = mid;
+      bestAssign.swap(assign);
     } else {
-      machines[1].tasksToDo.push_back(tasks[i]);
-      machines[1].Cmax += tasks[i].pj;
+      lo = mid + 1;
     }
   }
+
+  result.adopt(tasks, std::move(bestAssign));
 }
 
-// Algorytm optymalny (pełny przegląd permutacji) dla <=20 zadań:
-// Przegląda wszystkie możliwe permutacje przydziału zadań do maszyn i wybiera
-// najlepszy makespan.
-void opt(std::vector<Task> &tasks, std::vector<Machine> &machines) {
-  if (tasks.size() >= 20) {
-    std::cerr << "OPT algorithm is not suitable for more than 20 tasks.\n";
+// Różnicowanie Karmarkara-Karpa dla 2 maszyn: kopiec liczb, dwie największe
+// zastępowane różnicą (muszą trafić na różne maszyny). Każde różnicowanie to
+// krawędź w drzewie (różnica jest po stronie większej liczby), więc przydział
+// odtwarza dwukolorowanie drzewa od ostatniego węzła. side[j] - maszyna j.
+static void karmarkarKarpTwo(const std::vector<Task> &tasks,
+                             std::vector<int> &side) {
+  int n = tasks.size();
+  side.assign(n, 0);
+  if (n < 2)
     return;
+  // Węzły 0..n-1 to zadania, n.. to kolejne różnice
+  std::vector<int> larger(2 * n - 1, -1), smaller(2 * n - 1, -1);
+  std::priority_queue<std::pair<long long, int>> heap;
+  for (int j = 0; j < n; ++j)
+    heap.push({tasks[j].pj, j});
+
+  int node = n;
+  while (heap.size() > 1) {
+    auto a = heap.top();
+    heap.pop();
+    auto b = heap.top();
+    heap.pop();
+    larger[node] = a.second;
+    smaller[node] = b.second;
+    heap.push({a.first - b.first, node++});
   }
 
-  sortTasks(tasks); // sortowanie zadań
+  // Dwukolorowanie: większa liczba po stronie różnicy, mniejsza po drugiej
+  std::vector<char> color(node, 0);
+  for (int v = node - 1; v >= n; --v) {
+    color[larger[v]] = color[v];
+    color[smaller[v]] = !color[v];
+  }
+  for (int j = 0; j < n; ++j)
+    side[j] = color[j];
+}
+
+// Algorytm KK (Karmarkar-Karp, różnicowanie największych) dla m maszyn:
+// Każde zadanie to m-krotka obciążeń (pj, 0, ..., 0). Krotki są posortowane
+// malejąco i znormalizowane (minimum odjęte), a kopiec wybiera dwie o
+// największej rozpiętości. Łączy je największe z najmniejszym (A[i] +
+// B[m-1-i]), więc różnice się znoszą. Zadania pozycji krotki to listy
+// wiązane sklejane w O(1). Dla 2 maszyn - osobna ścieżka na liczbach.
+void karmarkarKarp(std::vector<Task> &tasks, Assignment &result) {
   int n = tasks.size();
-  int m = machines.size();
+  int m = result.load.size();
+  if (m == 2) {
+    std::vector<int> side;
+    karmarkarKarpTwo(tasks, side);
+    result.adopt(tasks, std::move(side));
+    return;
+  }
+  if (n == 0 || m < 2) {
+    listSchedule(tasks, result);
+    return;
+  }
 
-  std::vector<int> indices(n);
-  for (int i = 0; i < n; ++i) {
-    indices[i] = i; // indeksy zadań
+  // Krotka t to tylko pozycje z zadaniami (pozostałe mają obciążenie 0),
+  // posortowane malejąco - łącznie najwyżej n pozycji zamiast n * m.
+  // Pozycja: obciążenie i lista zadań head..tail, next[zadanie].
+  struct Slot {
+    long long load;
+    int head, tail;
+  };
+  std::vector<std::vector<Slot>> tuple(n);
+  std::vector<int> next(n, -1);
+  std::priority_queue<std::pair<long long, int>> heap; // (rozpiętość, krotka)
+  for (int j = 0; j < n; ++j) {
+    tuple[j] = {{tasks[j].pj, j, j}};
+    heap.push({tasks[j].pj, j});
+  }
+
+  std::vector<Slot> merged;
+  merged.reserve(m);
+  while (heap.size() > 1) {
+    int a = heap.top().second;
+    heap.pop();
+    int b = heap.top().second;
+    heap.pop();
+    const std::vector<Slot> &A = tuple[a], &B = tuple[b];
+    int sa = A.size(), sb = B.size();
+    merged.clear();
+    for (int i = 0; i < m; ++i) {
+      int y = m - 1 - i;
+      if (i >= sa && y >= sb)
+        continue; // obie pozycje puste
+      Slot slot = i < sa ? A[i] : Slot{0, -1, -1};
+      if (y < sb) { // doklej listę y
+        slot.load += B[y].load;
+        if (slot.head == -1)
+          slot.head = B[y].head;
+        else
+          next[slot.tail] = B[y].head;
+        slot.tail = B[y].tail;
+      }
+      merged.push_back(slot);
+    }
+    std::sort(merged.begin(), merged.end(),
+              [](const Slot &l, const Slot &r) { return l.load > r.load; });
+    // Przy pustej pozycji minimum to 0
+    long long base = (int)merged.size() < m ? 0 : merged.back().load;
+    for (auto &slot : merged)
+      slot.load -= base;
+    tuple[a].swap(merged); // wynik zastępuje krotkę a, bufor a wraca
+    std::vector<Slot>().swap(tuple[b]);
+    heap.push({tuple[a][0].load, a});
   }
 
-  int minCmax = std::numeric_limits<int>::max();
+  const std::vector<Slot> &last = tuple[heap.top().second];
+  std::vector<int> machineOf(n);
+  for (size_t i = 0; i < last.size(); ++i)
+    for (int j = last[i].head; j != -1; j = next[j])
+      machineOf[j] = i;
+  result.adopt(tasks, std::move(machineOf));
+}
 
-  // Przeglądaj wszystkie permutacje zadań
-  do {
-    // Wyzeruj maszyny
-    for (auto &machine : machines) {
-      machine.tasksToDo.clear();
-      machine.Cmax = 0;
+// Algorytm CKK (Complete Karmarkar-Karp, Korf) dla 2 maszyn:
+// Drzewo przeszukiwania na multizbiorach liczb - dwie największe zastępuje
+// najpierw ich różnica (jak KK, na różne maszyny), potem suma (na tę samą).
+// Liść: największa liczba >= suma reszty, różnica obciążeń to ich różnica.
+// Stos jest jawny, więc w każdej chwili najlepszy podział jest gotowy.
+// Kończy po przejrzeniu drzewa, po znalezieniu podziału idealnego (różnica
+// 0 lub 1) albo po timeLimitMs. optimal - czy wynik jest optymalny. Zwraca
+// false (bez harmonogramu) dla m != 2.
+bool completeKarmarkarKarp(std::vector<Task> &tasks, Assignment &result,
+                           bool &optimal, double timeLimitMs) {
+  optimal = false;
+  if (result.load.size() != 2) {
+    std::cerr << "CKK (Complete Karmarkar-Karp) implemented only for 2 "
+                 "machines!\n";
+    return false;
+  }
+  int n = tasks.size();
+  if (n == 0) {
+    optimal = true;
+    return true;
+  }
+
+  // Liczba na stosie: wartość i węzeł (0..n-1 - zadanie, n + d - liczba
+  // utworzona na głębokości d bieżącej ścieżki)
+  using Item = std::pair<long long, int>;
+  struct Combination {
+    int larger, smaller;
+    bool opposite; // różnica - składniki na różnych maszynach
+  };
+  struct Frame {
+    std::vector<Item> items; // malejąco
+    long long sum;
+    int branch; // 0 - różnica, 1 - suma, 2 - koniec
+  };
+  std::vector<Combination> path(n);
+
+  Frame root{{}, 0, 0};
+  for (int j = 0; j < n; ++j) {
+    root.items.push_back({tasks[j].pj, j});
+    root.sum += tasks[j].pj;
+  }
+  std::sort(root.items.begin(), root.items.end(), std::greater<Item>());
+  long long perfect = root.sum % 2;
+
+  long long best = std::numeric_limits<long long>::max();
+  std::vector<char> bestSide(n, 0), side(n);
+  // Rozwiązanie liścia: największa liczba na maszynie 0, reszta na 1
+  auto record = [&](const std::vector<Item> &items) {
+    std::vector<std::pair<int, char>> todo;
+    for (size_t i = 0; i < items.size(); ++i)
+      todo.push_back({items[i].second, i == 0 ? 0 : 1});
+    while (!todo.empty()) {
+      auto [node, s] = todo.back();
+      todo.pop_back();
+      if (node < n) {
+        side[node] = s;
+        continue;
+      }
+      const Combination &c = path[node - n];
+      todo.push_back({c.larger, s});
+      todo.push_back({c.smaller, c.opposite ? !s : s});
     }
+    bestSide = side;
+  };
 
-    // Przydziel zadania do maszyn cyklicznie według permutacji
-    for (int i = 0; i < n; ++i) {
-      int machineIndex = i % m;
-      machines[machineIndex].tasksToDo.push_back(tasks[indices[i]]);
-      machines[machineIndex].Cmax += tasks[indices[i]].pj;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<Frame> stack;
+  stack.push_back(std::move(root));
+  bool complete = true;
+  for (long long visited = 0; !stack.empty(); ++visited) {
+    if ((visited & 4095) == 0 &&
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start)
+                .count() > timeLimitMs) {
+      complete = false;
+      break;
+    }
+    Frame &f = stack.back();
+    if (f.branch == 0) {
+      long long rest = f.sum - f.items[0].first;
+      if (f.items[0].first >= rest) { // liść
+        if (f.items[0].first - rest < best) {
+          best = f.items[0].first - rest;
+          record(f.items);
+          if (best <= perfect)
+            break; // lepiej się nie da
+        }
+        stack.pop_back();
+        continue;
+      }
+    }
+    if (f.branch == 2) {
+      stack.pop_back();
+      continue;
+    }
+
+    int depth = stack.size() - 1;
+    Item a = f.items[0], b = f.items[1];
+    bool difference = f.branch == 0;
+    ++f.branch;
+    path[depth] = {a.second, b.second, difference};
+    Item combined{difference ? a.first - b.first : a.first + b.first,
+                  n + depth};
+    Frame child{{}, f.sum - a.first - b.first + combined.first, 0};
+    child.items.reserve(f.items.size() - 1);
+    auto rest = f.items.begin() + 2;
+    auto at = std::lower_bound(rest, f.items.end(), combined,
+                               std::greater<Item>());
+    child.items.insert(child.items.end(), rest, at);
+    child.items.push_back(combined);
+    child.items.insert(child.items.end(), at, f.items.end());
+    stack.push_back(std::move(child)); // f może być już nieaktualne
+  }
+
+  result.adopt(tasks, std::vector<int>(bestSide.begin(), bestSide.end()));
+  optimal = complete || best <= perfect;
+  return true;
+}
+
+// Posortowane rosnąco sumy wszystkich podzbiorów zadań [begin, end) razem
+// z maskami (bit j - zadanie j). Każde zadanie scala listę z jej kopią
+// przesuniętą o pj, więc całość kosztuje O(2^k) bez sortowania.
+static void sortedSubsetSums(const std::vector<Task> &tasks, int begin,
+                             int end,
+                             std::vector<std::pair<long long, uint64_t>> &sums) {
+  sums.assign(1, {0, 0});
+  std::vector<std::pair<long long, uint64_t>> shifted, merged;
+  for (int j = begin; j < end; ++j) {
+    shifted.resize(sums.size());
+    for (size_t i = 0; i < sums.size(); ++i)
+      shifted[i] = {sums[i].first + tasks[j].pj, sums[i].second | 1ull << j};
+    merged.resize(2 * sums.size());
+    std::merge(sums.begin(), sums.end(), shifted.begin(), shifted.end(),
+               merged.begin());
+    sums.swap(merged);
+  }
+}
+
+// Algorytm MITM (meet-in-the-middle, Schroeppel-Shamir) dla 2 maszyn i
+// n <= 60 zadań: zadania dzielone są na ćwiartki A, B, C, D, każda z
+// posortowanymi sumami podzbiorów (2^(n/4)). Sumy A + B są wydawane rosnąco,
+// a C + D malejąco przez kopce rozmiaru 2^(n/4), a dwa wskaźniki szukają
+// największej sumy <= sum / 2 dla maszyny 0. Pamięć O(2^(n/4)), czas
+// O(2^(n/2) log), niezależnie od wielkości pj. Zwraca false (bez
+// harmonogramu) dla m != 2 albo n > 60.
+bool meetInTheMiddle(std::vector<Task> &tasks, Assignment &result) {
+  int n = tasks.size();
+  if (result.load.size() != 2 || n > 60) {
+    std::cerr << "MITM (meet-in-the-middle) implemented only for 2 machines "
+                 "and up to 60 tasks!\n";
+    return false;
+  }
+  long long total = 0;
+  for (const auto &t : tasks)
+    total += t.pj;
+  long long target = total / 2;
+
+  using Sums = std::vector<std::pair<long long, uint64_t>>;
+  Sums quarter[4];
+  for (int q = 0; q < 4; ++q)
+    sortedSubsetSums(tasks, n * q / 4, n * (q + 1) / 4, quarter[q]);
+
+  // Strumień sum x[i] + y[j] z kopcem po i (j przesuwa się dla każdego i)
+  using Entry = std::tuple<long long, int, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> up;
+  std::priority_queue<Entry> down;
+  const Sums &a = quarter[0], &b = quarter[1], &c = quarter[2],
+             &d = quarter[3];
+  for (int i = 0; i < (int)a.size(); ++i)
+    up.push({a[i].first + b[0].first, i, 0});
+  int lastD = d.size() - 1;
+  for (int i = 0; i < (int)c.size(); ++i)
+    down.push({c[i].first + d[lastD].first, i, lastD});
+
+  long long best = -1;
+  uint64_t bestMask = 0;
+  while (!up.empty() && !down.empty()) {
+    auto [left, i, j] = up.top();
+    auto [right, k, l] = down.top();
+    if (left + right > target) { // mniejsza suma prawej połowy
+      down.pop();
+      if (l > 0)
+        down.push({c[k].first + d[l - 1].first, k, l - 1});
+      continue;
+    }
+    if (left + right > best) {
+      best = left + right;
+      bestMask = a[i].second | b[j].second | c[k].second | d[l].second;
+      if (best == target)
+        break; // podział idealny
+    }
+    up.pop(); // większa suma lewej połowy
+    if (j + 1 < (int)b.size())
+      up.push({a[i].first + b[j + 1].first, i, j + 1});
+  }
+
+  std::vector<int> machineOf(n);
+  for (int j = 0; j < n; ++j)
+    machineOf[j] = (bestMask >> j & 1) ? 0 : 1;
+  result.adopt(tasks, std::move(machineOf));
+  return true;
+}
+
+// Postać o dużej krotności: sortuje zadania malejąco i zwija równe pj w
+// grupy (pj, liczba). Grupa g to kolejne count zadań posortowanego wektora.
+void groupTasks(std::vector<Task> &tasks, std::vector<TaskGroup> &groups) {
+  sortTasks(tasks);
+  groups.clear();
+  for (const auto &t : tasks) {
+    if (groups.empty() || groups.back().pj != t.pj)
+      groups.push_back({t.pj, 0});
+    ++groups.back().count;
+  }
+}
+
+// Czy grupy mieszczą się na m maszynach przy Cmax <= capacity (podział i
+// ograniczenia po liczbach): maszyny dostają kolejno konfiguracje (ile
+// zadań z każdej grupy), od najpełniejszych. Suma luk maszyn nie może
+// przekroczyć m * capacity - sum, a stany (maszyna, pozostałe liczby) bez
+// rozwiązania są zapamiętywane - to też usuwa permutacje maszyn.
+// nodesLeft - wspólny budżet węzłów; po jego wyczerpaniu (nodesLeft < 0)
+// wynik false nic nie rozstrzyga.
+static bool packCounts(const std::vector<TaskGroup> &groups, int m,
+                       long long capacity,
+                       std::vector<std::vector<int>> &config,
+                       long long &nodesLeft) {
+  int d = groups.size();
+  long long total = 0, unit = 0;
+  for (const auto &g : groups) {
+    total += (long long)g.pj * g.count;
+    unit = std::gcd(unit, (long long)g.pj);
+  }
+  capacity -= capacity % unit; // obciążenia są wielokrotnościami NWD czasów
+  if ((long long)m * capacity < total)
+    return false;
+
+  std::vector<int> rem(d);
+  for (int g = 0; g < d; ++g)
+    rem[g] = groups[g].count;
+  config.assign(m, std::vector<int>(d, 0));
+  std::unordered_set<std::vector<int>, LoadsHash> failed;
+  const size_t maxFailed = 2000000;
+  long long wasteLeft = (long long)m * capacity - total;
+
+  // Na przedostatniej maszynie ostatnia dostaje resztę, więc przy ustalonych
+  // rem wynik zależy tylko od (g, load) - nieudane pary są zapamiętywane
+  std::vector<std::unordered_set<long long>> failedLoads(d + 1);
+  const size_t maxFailedLoads = 4000000;
+  size_t failedLoadsCount = 0;
+
+  std::function<bool(int)> fillMachine;
+  // Konfiguracja maszyny k od grupy g przy obciążeniu load
+  std::function<bool(int, int, long long)> chooseCounts =
+      [&](int k, int g, long long load) {
+        if (--nodesLeft < 0)
+          return false;
+        bool memo = k == m - 2;
+        if (memo && failedLoads[g].count(load))
+          return false;
+        if (g == d) {
+          long long waste = capacity - load;
+          if (waste > wasteLeft)
+            return false;
+          wasteLeft -= waste;
+          bool ok = fillMachine(k + 1);
+          wasteLeft += waste;
+          if (!ok && memo && failedLoadsCount < maxFailedLoads &&
+              nodesLeft >= 0) {
+            failedLoads[g].insert(load);
+            ++failedLoadsCount;
+          }
+          return ok;
+        }
+        // Mniejsze grupy muszą dopełnić maszynę do capacity - wasteLeft
+        long long room = capacity - load, further = 0;
+        for (int h = g; h < d && further < room; ++h)
+          further += std::min<long long>(rem[h], room / groups[h].pj) *
+                     groups[h].pj;
+        if (load + std::min(further, room) < capacity - wasteLeft)
+          return false;
+        // Liczby od proporcjonalnej do reszty pojemności (rem[g] * room /
+        // pozostała suma), potem na przemian coraz dalej od niej
+        int most = std::min<long long>(rem[g], room / groups[g].pj);
+        long long left = 0;
+        for (int h = g; h < d; ++h)
+          left += (long long)rem[h] * groups[h].pj;
+        int ideal = left > 0 ? std::min<long long>(
+                                   most, (__int128)rem[g] * room / left)
+                             : 0;
+        for (int i = 0; i <= 2 * most; ++i) {
+          int c = i % 2 ? ideal - (i + 1) / 2 : ideal + i / 2;
+          if (c < 0 || c > most)
+            continue;
+          rem[g] -= c;
+          config[k][g] = c;
+          bool ok = chooseCounts(k, g + 1, load + (long long)c * groups[g].pj);
+          rem[g] += c;
+          if (ok)
+            return true;
+        }
+        config[k][g] = 0;
+        if (memo && failedLoadsCount < maxFailedLoads && nodesLeft >= 0) {
+          failedLoads[g].insert(load);
+          ++failedLoadsCount;
+        }
+        return false;
+      };
+  fillMachine = [&](int k) {
+    if (k == m)
+      return std::all_of(rem.begin(), rem.end(), [](int c) { return c == 0; });
+    if (k == m - 1) { // ostatnia maszyna dostaje wszystkie pozostałe zadania
+      long long load = 0;
+      for (int g = 0; g < d; ++g) {
+        config[k][g] = rem[g];
+        load += (long long)rem[g] * groups[g].pj;
+      }
+      if (load > capacity)
+        return false;
+      std::fill(rem.begin(), rem.end(), 0);
+      return true;
+    }
+    std::vector<int> key = rem;
+    key.push_back(k);
+    if (failed.count(key))
+      return false;
+    if (k == m - 2) { // pary (g, load) są ważne tylko przy tych samych rem
+      for (auto &loads : failedLoads)
+        loads.clear();
+      failedLoadsCount = 0;
+    }
+    if (chooseCounts(k, 0, 0))
+      return true;
+    if (failed.size() < maxFailed && nodesLeft >= 0)
+      failed.insert(key);
+    return false;
+  };
+  return fillMachine(0);
+}
+
+// Algorytm HM (duża krotność) - dokładny na postaci (pj, liczba):
+// Cel Cmax wybiera searchTarget między ograniczeniem dolnym (L0/L1/L2) a
+// wynikiem LPT, a packCounts sprawdza cel na liczbach zadań d typów zamiast
+// na pojedynczych zadaniach - także dla 2 maszyn, bez tablic po sumach.
+// Zwraca false (bez harmonogramu) po wyczerpaniu budżetu węzłów.
+bool highMultiplicity(std::vector<Task> &tasks, Assignment &result) {
+  int m = result.load.size();
+  std::vector<TaskGroup> groups;
+  groupTasks(tasks, groups); // zadania posortowane malejąco
+
+  listSchedule(tasks, result); // LPT - ograniczenie górne i rezerwa
+  if (groups.empty() || m < 2)
+    return true;
+  long long upperBound = result.cmax();
+
+  // Cel Cmax między ograniczeniem dolnym a LPT; znaleziona konfiguracja
+  // zawęża górną granicę do swojego Cmax
+  std::vector<std::vector<int>> config, bestConfig;
+  long long nodesLeft = 3000000; // wspólny dla wszystkich celów
+  searchTarget(computeLowerBounds(tasks, m).best(), upperBound,
+               [&](long long target) -> long long {
+                 if (nodesLeft < 0 ||
+                     !packCounts(groups, m, target, config, nodesLeft))
+                   return -1;
+                 long long cmax = 0;
+                 for (int k = 0; k < m; ++k) {
+                   long long load = 0;
+                   for (size_t g = 0; g < groups.size(); ++g)
+                     load += (long long)config[k][g] * groups[g].pj;
+                   cmax = std::max(cmax, load);
+                 }
+                 bestConfig.swap(config);
+                 return cmax;
+               });
+  if (nodesLeft < 0)
+    return false;
+  if (bestConfig.empty())
+    return true; // LPT jest optymalny
+
+  // Rozdziel zadania grup według konfiguracji
+  std::vector<int> machineOf(tasks.size());
+  size_t next = 0;
+  for (size_t g = 0; g < groups.size(); ++g)
+    for (int k = 0; k < m; ++k)
+      for (int c = 0; c < bestConfig[k][g]; ++c)
+        machineOf[next++] = k;
+  result.adopt(tasks, std::move(machineOf));
+  return true;
+}
+
+// Pakowanie bin completion (Korf) zadań p (malejąco) na m maszyn o
+// pojemności capacity. Maszyny są zapełniane po kolei; każda dostaje
+// największe pozostałe zadanie i jedno z niezdominowanych uzupełnień:
+// maksymalne (nic już się nie zmieści), z luką w granicach m * capacity -
+// sum, i bez zadania (albo pary zadań), które da się zastąpić większym
+// pozostałym zadaniem. Uzupełnienia powstają od największych zadań.
+// nogoods[stan] - największa pojemność, przy której stan (pozostałe
+// zadania, numer maszyny) nie ma rozwiązania; przy mniejszej też go nie ma,
+// więc wpisy są wspólne dla wszystkich prób bisekcji. nodesLeft - wspólny
+// budżet węzłów; po jego wyczerpaniu (nodesLeft < 0) wynik false nic nie
+// rozstrzyga.
+static bool binCompletionPack(
+    const std::vector<int> &p, int m, long long capacity,
+    std::vector<int> &assign,
+    std::unordered_map<std::vector<int>, long long, LoadsHash> &nogoods,
+    long long &nodesLeft) {
+  int n = p.size();
+  long long total = 0;
+  for (int x : p)
+    total += x;
+  if ((long long)m * capacity < total)
+    return false;
+  std::vector<char> used(n, 0);
+  assign.assign(n, -1);
+  const size_t maxNogoods = 2000000;
+
+  std::function<bool(int, long long)> pack = [&](int bin, long long wasteLeft) {
+    int x = 0;
+    while (x < n && used[x])
+      ++x;
+    if (x == n)
+      return true;
+    if (bin == m || --nodesLeft < 0)
+      return false;
+    std::vector<int> key;
+    for (int j = x; j < n; ++j)
+      if (!used[j])
+        key.push_back(p[j]);
+    key.push_back(-bin);
+    auto known = nogoods.find(key);
+    if (known != nogoods.end() && known->second >= capacity)
+      return false;
+
+    // Niezdominowane uzupełnienia maszyny zawierające zadanie x - każde
+    // sprawdzane od razu na kolejnych maszynach
+    std::vector<int> chosen = {x};
+    used[x] = 1;
+    std::function<bool(int, long long)> complete = [&](int from,
+                                                       long long sum) {
+      if (--nodesLeft < 0)
+        return false;
+      bool maximal = true;
+      for (int j = n - 1; j > x && maximal; --j) // najmniejsze na końcu
+        if (!used[j])
+          maximal = sum + p[j] > capacity;
+      if (maximal && capacity - sum <= wasteLeft) {
+        bool dominated = false;
+        for (size_t a = 1; a < chosen.size() && !dominated; ++a)
+          for (int z = x + 1; z < n && !dominated; ++z) {
+            if (used[z] || p[z] <= p[chosen[a]])
+              continue;
+            dominated = sum - p[chosen[a]] + p[z] <= capacity;
+            for (size_t b = a + 1; b < chosen.size() && !dominated; ++b)
+              dominated = p[z] >= p[chosen[a]] + p[chosen[b]] &&
+                          sum - p[chosen[a]] - p[chosen[b]] + p[z] <= capacity;
+          }
+        if (!dominated) {
+          for (int j : chosen)
+            assign[j] = bin;
+          if (pack(bin + 1, wasteLeft - (capacity - sum)))
+            return true;
+        }
+      }
+      int lastSize = -1;
+      for (int j = from; j < n; ++j) {
+        if (used[j] || p[j] == lastSize || sum + p[j] > capacity)
+          continue;
+        lastSize = p[j]; // równe zadania - tylko pierwsze na tym poziomie
+        used[j] = 1;
+        chosen.push_back(j);
+        bool ok = complete(j + 1, sum + p[j]);
+        chosen.pop_back();
+        used[j] = 0;
+        if (ok)
+          return true;
+      }
+      return false;
+    };
+    bool ok = complete(x + 1, p[x]);
+    used[x] = 0;
+    if (ok)
+      return true;
+    // Zapis po rekurencji, która mogła przebudować tablicę - bez iteratora
+    // sprzed niej; zapisana wcześniej pojemność jest mniejsza od capacity
+    if (nogoods.size() < maxNogoods && nodesLeft >= 0)
+      nogoods[key] = capacity;
+    return false;
+  };
+  return pack(0, (long long)m * capacity - total);
+}
+
+// Algorytm BC (bin completion) - dokładny:
+// Bisekcja celu Cmax między ograniczeniem dolnym max(p_max, ceil(sum / m),
+// p_m + p_m+1) a wynikiem LPT, każda próba to pakowanie binCompletionPack.
+// Udane pakowanie od razu obniża górną granicę do swojego Cmax. Zwraca
+// false (bez harmonogramu) po wyczerpaniu budżetu węzłów.
+bool binCompletion(std::vector<Task> &tasks, Assignment &result) {
+  sortTasks(tasks); // sortowanie zadań malejąco
+  int n = tasks.size();
+  int m = result.load.size();
+  listSchedule(tasks, result); // LPT - górna granica i rezerwa
+  if (n == 0)
+    return true;
+
+  std::vector<int> p(n);
+  long long total = 0;
+  for (int j = 0; j < n; ++j) {
+    p[j] = tasks[j].pj;
+    total += p[j];
+  }
+  long long lo = std::max<long long>(p[0], (total + m - 1) / m);
+  if (n > m)
+    lo = std::max<long long>(lo, p[m - 1] + p[m]);
+  long long hi = result.cmax();
+
+  std::unordered_map<std::vector<int>, long long, LoadsHash> nogoods;
+  std::vector<int> assign, bestAssign;
+  long long nodesLeft = 3000000; // wspólny dla wszystkich prób, ok. 1 s
+  while (lo < hi) {
+    long long mid = lo + (hi - lo) / 2;
+    if (binCompletionPack(p, m, mid, assign, nogoods, nodesLeft)) {
+      std::vector<long long> load(m, 0);
+      for (int j = 0; j < n; ++j)
+        load[assign[j]] += p[j];
+      hi = *std::max_element(load.begin(), load.end());
+      bestAssign = assign;
+    } else if (nodesLeft < 0) {
+      return false;
+    } else {
+      lo = mid + 1;
     }
+  }
+  if (!bestAssign.empty()) // puste - LPT jest optymalny
+    result.adopt(tasks, std::move(bestAssign));
+  return true;
+}
 
-    int currentCmax = calculateCmax(machines);
+// Ograniczenie dolne Martello-Totha (L2) liczby pojemników o pojemności
+// capacity dla zadań posortowanych rosnąco (prefix - sumy prefiksowe).
+// Dla każdego progu alfa z {0} i czasów <= capacity / 2: zadania większe od
+// capacity - alfa i większe od połowy wymagają osobnych pojemników, a
+// zadania z [alfa, capacity / 2] muszą zmieścić się w ich lukach albo
+// w nowych pojemnikach. O(n log n).
+static long long binPackingBound(const std::vector<int> &ascending,
+                                 const std::vector<long long> &prefix,
+                                 long long capacity) {
+  int n = ascending.size();
+  auto firstAbove = [&](long long value) { // indeks pierwszego > value
+    return (int)(std::upper_bound(ascending.begin(), ascending.end(), value) -
+                 ascending.begin());
+  };
+  int half = firstAbove(capacity / 2); // od half: pj > capacity / 2
+  // J1: pj > capacity - alfa, J2: reszta > capacity / 2,
+  // J3: alfa <= pj <= capacity / 2 (od indeksu from)
+  auto evaluate = [&](long long alpha, int from) {
+    int big = firstAbove(capacity - alpha);
+    long long count2 = big - half;
+    long long sum2 = prefix[big] - prefix[half];
+    long long spill = prefix[half] - prefix[from] - (count2 * capacity - sum2);
+    return (n - big) + count2 +
+           std::max<long long>(0, (spill + capacity - 1) / capacity);
+  };
+  long long best = evaluate(0, 0);
+  for (int i = 0; i < half; ++i)
+    if (i == 0 || ascending[i] != ascending[i - 1])
+      best = std::max(best, evaluate(ascending[i], i));
+  return best;
+}
 
-    if (currentCmax < minCmax) {
-      minCmax = currentCmax;
+// Ograniczenia dolne Cmax (Dell'Amico, Martello) w O(n log n):
+// L0 = max(p_max, ceil(sum / m)); L1 - któraś maszyna dostaje k + 1 z km + 1
+// największych zadań, więc max po k sumy k + 1 najmniejszych z nich (k = 1
+// to p_m + p_m+1); L2 - najmniejsze C >= max(L0, L1), dla którego
+// ograniczenie L2 pakowania w pojemniki C nie przekracza m (bisekcja).
+LowerBounds computeLowerBounds(const std::vector<Task> &tasks, int m) {
+  LowerBounds bounds{0, 0, 0};
+  int n = tasks.size();
+  if (n == 0 || m <= 0)
+    return bounds;
+  std::vector<int> ascending(n);
+  for (int j = 0; j < n; ++j)
+    ascending[j] = tasks[j].pj;
+  std::sort(ascending.begin(), ascending.end());
+  std::vector<long long> prefix(n + 1, 0);
+  for (int j = 0; j < n; ++j)
+    prefix[j + 1] = prefix[j] + ascending[j];
+
+  bounds.l0 = std::max<long long>(ascending[n - 1], (prefix[n] + m - 1) / m);
+  // Zadania malejąco: i-te największe to ascending[n - 1 - i]
+  for (int k = 1; (long long)k * m < n; ++k) {
+    int last = n - 1 - k * m; // (km + 1)-sze największe
+    bounds.l1 = std::max(bounds.l1, prefix[last + k + 1] - prefix[last]);
+  }
+
+  long long lo = std::max(bounds.l0, bounds.l1), hi = prefix[n];
+  while (lo < hi) {
+    long long mid = lo + (hi - lo) / 2;
+    if (binPackingBound(ascending, prefix, mid) <= m)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  bounds.l2 = lo;
+  return bounds;
+}
+
+// Poprawa lokalna dowolnego przydziału: wymiany między najbardziej i
+// najmniej obciążoną maszyną (kopce maksimum i minimum obciążeń). Ruch
+// przenosi z maszyny max jedno lub dwa zadania i w zamian zabiera z
+// maszyny min zero, jedno lub dwa zadania (przeniesienie, zamiana, 2 za 1,
+// 1 za 2, 2 za 2). Różnica delta przeniesionej pracy poprawia parę, gdy
+// 0 < delta < Cmax(max) - Cmax(min); wybierana jest najbliższa połowie
+// różnicy (wyszukiwanie binarne po posortowanych sumach). Działa na
+// przydziale result; miejsca zadań na roboczych listach maszyn są pamiętane,
+// więc wyjęcie zadania to O(1), a aktualizacja kopców O(log m). Kończy, gdy
+// nie ma poprawiającej wymiany; zwraca liczbę wykonanych wymian.
+int localSearch(const std::vector<Task> &tasks, Assignment &result) {
+  int m = result.load.size();
+  if (m < 2)
+    return 0;
+  // Robocze listy pozycji zadań maszyn; slot[j] - miejsce zadania j na liście
+  std::vector<std::vector<int>> lists(m);
+  std::vector<int> start, order, slot(tasks.size());
+  result.views(start, order);
+  for (int k = 0; k < m; ++k) {
+    lists[k].assign(order.begin() + start[k], order.begin() + start[k + 1]);
+    for (size_t i = 0; i < lists[k].size(); ++i)
+      slot[lists[k][i]] = i;
+  }
+  auto &load = result.load;
+  LoadHeap maxHeap(load, true), minHeap(load);
+
+  auto takeTask = [&](int k, int j) {
+    auto &list = lists[k];
+    list[slot[j]] = list.back();
+    slot[list[slot[j]]] = slot[j];
+    list.pop_back();
+    load[k] -= tasks[j].pj;
+  };
+  auto putTask = [&](int k, int j) {
+    slot[j] = lists[k].size();
+    lists[k].push_back(j);
+    result.assign(j, k, tasks[j].pj);
+  };
+
+  // Zbiór zero, jednego lub dwóch zadań jednej maszyny (pozycje zadań)
+  struct Pick {
+    long long sum;
+    int first, second;
+  };
+  const size_t pairLimit = 2000; // pary tylko dla krótkich list
+  auto picks = [&](const std::vector<int> &list, bool withEmpty) {
+    std::vector<Pick> out;
+    if (withEmpty)
+      out.push_back({0, -1, -1});
+    for (size_t i = 0; i < list.size(); ++i) {
+      out.push_back({tasks[list[i]].pj, list[i], -1});
+      if (list.size() <= pairLimit)
+        for (size_t j = i + 1; j < list.size(); ++j)
+          out.push_back({(long long)tasks[list[i]].pj + tasks[list[j]].pj,
+                         list[i], list[j]});
+    }
+    return out;
+  };
+
+  int improvements = 0;
+  while (true) {
+    int high = maxHeap.top(), low = minHeap.top();
+    long long diff = load[high] - load[low];
+    if (diff < 2)
+      break;
+
+    std::vector<Pick> given = picks(lists[high], false);
+    std::vector<Pick> taken = picks(lists[low], true);
+    std::sort(taken.begin(), taken.end(),
+              [](const Pick &a, const Pick &b) { return a.sum < b.sum; });
+    long long bestScore = diff; // |2 * delta - diff| < diff <=> poprawa
+    Pick bestGiven{0, -1, -1}, bestTaken{0, -1, -1};
+    for (const Pick &g : given) {
+      // delta = g.sum - t.sum, najlepiej t.sum = g.sum - diff / 2
+      long long want = g.sum - diff / 2;
+      auto it = std::lower_bound(
+          taken.begin(), taken.end(), want,
+          [](const Pick &t, long long value) { return t.sum < value; });
+      for (auto c = it - (it != taken.begin()); c != taken.end() && c <= it;
+           ++c) {
+        long long delta = g.sum - c->sum;
+        long long score = std::llabs(2 * delta - diff);
+        if (delta > 0 && delta < diff && score < bestScore) {
+          bestScore = score;
+          bestGiven = g;
+          bestTaken = *c;
+        }
+      }
     }
+    if (bestGiven.first == -1)
+      break; // brak poprawiającej wymiany
 
-  } while (std::next_permutation(indices.begin(), indices.end()));
+    std::vector<int> toLow, toHigh;
+    for (int j : {bestGiven.first, bestGiven.second})
+      if (j != -1) {
+        takeTask(high, j);
+        toLow.push_back(j);
+      }
+    for (int j : {bestTaken.first, bestTaken.second})
+      if (j != -1) {
+        takeTask(low, j);
+        toHigh.push_back(j);
+      }
+    for (int j : toLow)
+      putTask(low, j);
+    for (int j : toHigh)
+      putTask(high, j);
+    for (int k : {high, low}) {
+      maxHeap.update(k, load[k]);
+      minHeap.update(k, load[k]);
+    }
+    ++improvements;
+  }
+  return improvements;
+}
+
+
+OnlineScheduler::OnlineScheduler(int machines, Policy policy)
+    : policy(policy), heap(std::vector<long long>(machines)), order(machines) {
+  for (int k = 0; k < machines; ++k)
+    order[k] = k;
+}
+
+int OnlineScheduler::assign(int pj) {
+  int m = order.size();
+  int k = heap.top(); // Graham: najmniej obciążona maszyna
+  if (policy == Kpt) {
+    // Maszyna order[i] (i >= 1) jest dopuszczalna, gdy po dodaniu zadania
+    // jej obciążenie nie przekracza alpha * średniej z i niżej obciążonych.
+    // Przegląd od najwyżej obciążonej kończy pierwsza dopuszczalna; suma
+    // niższych to suma wszystkich minus przejrzane.
+    const double alpha = 1.945;
+    const auto &load = heap.load;
+    long long below = total;
+    int rank = 0;
+    for (int i = m - 1; i >= 1; --i) {
+      below -= load[order[i]];
+      if ((double)(load[order[i]] + pj) * i <= alpha * below) {
+        rank = i;
+        break;
+      }
+    }
+    k = order[rank];
+    heap.update(k, heap.load[k] + pj);
+    // Przywrócenie porządku - maszyna przesuwa się tylko w górę, za
+    // wszystkie maszyny o mniejszym obciążeniu
+    auto from = order.begin() + rank;
+    auto to = std::lower_bound(from + 1, order.end(), heap.load[k],
+                               [&](int x, long long v) { return load[x] < v; });
+    std::rotate(from, from + 1, to);
+  } else {
+    heap.update(k, heap.load[k] + pj);
+  }
+  total += pj;
+  maxLoad = std::max(maxLoad, heap.load[k]);
+  return k;
+}
+
+// Czyta zadania ze strumienia w formacie plików testowych (liczba zadań, potem
+// czasy pj) i przydziela je po jednym, bez budowania listy zadań. Przydziały
+// "zadanie maszyna" wypisuje do assignments. Zwraca liczbę zadań.
+long long scheduleOnline(std::istream &input, OnlineScheduler &scheduler,
+                         std::ostream *assignments) {
+  long long n = 0, count = 0;
+  int pj;
+  input >> n; // liczba zadań
+  while (count < n && input >> pj) {
+    int k = scheduler.assign(pj);
+    ++count;
+    if (assignments)
+      *assignments << count << " " << k << "\n";
+  }
+  if (count < n)
+    std::cerr << "Warning: expected " << n << " tasks, read " << count << "\n";
+  return count;
+}
+
+DynamicSchedule::DynamicSchedule(int machines, int maxMigrations)
+    : tasks(machines), minHeap(std::vector<long long>(machines)),
+      maxHeap(std::vector<long long>(machines), true),
+      maxMigrations(maxMigrations) {}
+
+void DynamicSchedule::setLoad(int machine, long long load) {
+  minHeap.update(machine, load);
+  maxHeap.update(machine, load);
+}
+
+// Nowe zadanie trafia na najmniej obciążoną maszynę (jak w LSA), co samo
+// utrzymuje równowagę - migracje są potrzebne dopiero po usunięciach.
+int DynamicSchedule::insert(const Task &task) {
+  if (where.count(task.index)) {
+    std::cerr << "Error: Task " << task.index << " already scheduled\n";
+    return -1;
+  }
+  int k = minHeap.top();
+  tasks[k].insert({task.pj, task.index});
+  where[task.index] = {k, task.pj};
+  setLoad(k, minHeap.load[k] + task.pj);
+  return k;
+}
+
+bool DynamicSchedule::remove(int taskIndex) {
+  auto it = where.find(taskIndex);
+  if (it == where.end())
+    return false;
+  auto [k, pj] = it->second;
+  tasks[k].erase({pj, taskIndex});
+  where.erase(it);
+  setLoad(k, minHeap.load[k] - pj);
+  rebalance(maxMigrations);
+  return true;
+}
+
+// Przenosi zadanie z maszyny o największym na maszynę o najmniejszym
+// obciążeniu, dopóki różnica d się zmniejsza. Najlepsze jest zadanie o czasie
+// najbliższym d / 2; przeniesienie p < d zawsze obniża maksimum tej pary.
+int DynamicSchedule::rebalance(int migrations) {
+  int moved = 0;
+  while (moved < migrations) {
+    int high = maxHeap.top(), low = minHeap.top();
+    long long diff = maxHeap.load[high] - minHeap.load[low];
+    if (diff < 2)
+      break;
+    auto &from = tasks[high];
+    int half = std::min<long long>(diff / 2, std::numeric_limits<int>::max());
+    auto it = from.lower_bound({half, 0});
+    auto best = from.end();
+    if (it != from.end() && it->first < diff)
+      best = it;
+    if (it != from.begin() && std::prev(it)->first > 0) {
+      auto prev = std::prev(it);
+      if (best == from.end() ||
+          std::llabs(2LL * prev->first - diff) <
+              std::llabs(2LL * best->first - diff))
+        best = prev;
+    }
+    if (best == from.end())
+      break; // każde zadanie jest zbyt długie
+
+    auto [pj, index] = *best;
+    from.erase(best);
+    tasks[low].insert({pj, index});
+    where[index].first = low;
+    setLoad(high, maxHeap.load[high] - pj);
+    setLoad(low, minHeap.load[low] + pj);
+    ++moved;
+  }
+  return moved;
+}
+
+// Materializuje przydział w postaci wektora maszyn.
+void DynamicSchedule::toMachines(std::vector<Machine> &machines) const {
+  createMachines(machines, tasks.size());
+  for (size_t k = 0; k < tasks.size(); ++k)
+    for (const auto &[pj, index] : tasks[k]) {
+      machines[k].tasksToDo.push_back({index, pj});
+      machines[k].Cmax += pj;
+    }
+}
+
+// Płaszczyzna obciążeń (a, b) maszyn 0 i 1 osiągalnych przez zadania
+// p[begin..end), a <= A, b <= B, obciążenie maszyny 2 (reszta) <= C. Wiersz a
+// to bitset obciążeń b; zadanie p to wiersz |= wiersz << p (na maszynę 1)
+// oraz wiersz a |= wiersz a - p (na maszynę 0), wiersze od najwyższego, więc
+// można to robić w miejscu. Przetwarzany jest tylko pas
+// prefiks - a - C <= b <= prefiks - a; bity pod pasem zostają (to stany
+// osiągalne, tylko z przepełnioną maszyną 2).
+static void loadPlane(const std::vector<int> &p, int begin, int end, int A,
+                      int B, long long C, std::vector<uint64_t> &plane) {
+  const int words = B / 64 + 1;
+  plane.assign((size_t)(A + 1) * words, 0);
+  plane[0] = 1;
+  long long prefix = 0;
+  for (int j = begin; j < end; ++j) {
+    prefix += p[j];
+    long long lowest = std::max<long long>(0, prefix - B - C);
+    for (long long a = std::min<long long>(A, prefix); a >= lowest; --a) {
+      uint64_t *row = &plane[a * words];
+      long long low = std::max<long long>(0, prefix - a - C);
+      int used = std::min<long long>(B, prefix - a) / 64 + 1;
+      int from = std::max<long long>(0, low - p[j]) / 64;
+      if (p[j] <= B && from < used)
+        addToBitset(row + from, used - from, p[j]);
+      if (a >= p[j]) {
+        const uint64_t *source = row - (size_t)p[j] * words;
+        for (int w = low / 64; w < used; ++w)
+          row[w] |= source[w];
+      }
+    }
+  }
+}
+
+// Płaszczyzna pozostałych obciążeń (x, y) = (A - a, B - b) po przydzieleniu
+// zadań p[begin..end), zaczynając od stanu (A, B) - przesunięcia w dół,
+// wiersze od najniższego. Maszyna 2 dostaje c = sufiks - a - b, 0 <= c <= C,
+// więc przetwarzany jest tylko pas A + B - sufiks <= x + y
+// <= A + B + C - sufiks.
+static void remainingPlane(const std::vector<int> &p, int begin, int end,
+                           int A, int B, long long C,
+                           std::vector<uint64_t> &plane) {
+  const int words = B / 64 + 1;
+  plane.assign((size_t)(A + 1) * words, 0);
+  plane[(size_t)A * words + B / 64] = 1ULL << (B % 64);
+  long long suffix = 0;
+  for (int j = begin; j < end; ++j) {
+    suffix += p[j];
+    long long band = (long long)A + B - suffix; // najmniejsze x + y
+    long long highest = std::min<long long>(A, band + C);
+    for (long long x = std::max<long long>(0, A - suffix); x <= highest; ++x) {
+      uint64_t *row = &plane[x * words];
+      int low = std::max<long long>(0, band - x) / 64;
+      long long high = std::min<long long>(B, band + C - x);
+      // źródła przesunięcia leżą do p powyżej pasa
+      int reach = std::min<long long>(words, (high + p[j]) / 64 + 1);
+      if (p[j] <= B)
+        subtractFromBitset(row + low, reach - low, p[j]);
+      if (x + p[j] <= A) {
+        const uint64_t *source = row + (size_t)p[j] * words;
+        for (int w = low; w <= high / 64; ++w)
+          row[w] |= source[w];
+      }
+    }
+  }
+}
+
+// Odtworzenie przydziału o obciążeniach (A, B, reszta) zadań p[begin..end)
+// metodą Hirschberga: płaszczyzna pierwszej połowy i płaszczyzna pozostałych
+// obciążeń drugiej mają wspólny punkt (a1, b1) - podział celu na połowy.
+// Cele połówek sumują się do (A, B), więc każdy poziom rekursji kosztuje
+// najwyżej tyle, co jedno DP, a pamięć jest zwalniana przed zejściem.
+static void splitThree(const std::vector<int> &p, int begin, int end, int A,
+                       int B, std::vector<int> &assign) {
+  if (A == 0 && B == 0) {
+    std::fill(assign.begin() + begin, assign.begin() + end, 2);
+    return;
+  }
+  if (end - begin == 1) {
+    assign[begin] = A == p[begin] ? 0 : (B == p[begin] ? 1 : 2);
+    return;
+  }
+  int mid = (begin + end) / 2;
+  int a1 = 0, b1 = 0;
+  {
+    std::vector<uint64_t> first, second;
+    long long rest = -A - B; // obciążenie maszyny 2 w tym fragmencie
+    for (int j = begin; j < end; ++j)
+      rest += p[j];
+    loadPlane(p, begin, mid, A, B, rest, first);
+    remainingPlane(p, mid, end, A, B, rest, second);
+    const int words = B / 64 + 1;
+    const uint64_t topMask = ~0ULL >> (63 - B % 64);
+    bool found = false;
+    for (int a = 0; a <= A && !found; ++a)
+      for (int w = 0; w < words; ++w) {
+        size_t at = (size_t)a * words + w;
+        uint64_t common = first[at] & second[at];
+        if (w == words - 1)
+          common &= topMask;
+        if (common) {
+          a1 = a;
+          b1 = w * 64 + __builtin_ctzll(common);
+          found = true;
+          break;
+        }
+      }
+  }
+  splitThree(p, begin, mid, a1, b1, assign);
+  splitThree(p, mid, end, A - a1, B - b1, assign);
+}
+
+// Algorytm dokładny dla 3 maszyn: DP bitsetowe na płaszczyźnie obciążeń
+// (load1, load2), load3 = suma - load1 - load2. Obciążenia są ograniczone
+// przez min(LPT - 1, suma / 2) (jeśli p_max <= suma / 2, to OPT <= suma / 2 -
+// inaczej przeniesienie mniejszego zadania z maszyny > suma / 2 poprawia
+// wynik), więc płaszczyzna ma ok. (suma / 3)^2 bitów - 140 MB dla sumy 10^5.
+// Przydział odtwarza splitThree. Zwraca false, gdy nie liczy: dla m != 3
+// albo zbyt dużej płaszczyzny.
+bool threeMachineDp(std::vector<Task> &tasks, Assignment &result) {
+  if (result.load.size() != 3) {
+    std::cerr << "DP3 (three-machine DP) implemented only for 3 machines!\n";
+    return false;
+  }
+  sortTasks(tasks); // sortowanie zadań malejąco
+  listSchedule(tasks, result); // LPT - górna granica
+  int n = tasks.size();
+  long long total = 0;
+  for (const auto &t : tasks)
+    total += t.pj;
+  long long upperBound = result.cmax();
+  if (n == 0 || upperBound == computeLowerBounds(tasks, 3).best())
+    return true; // LPT jest optymalny
+
+  long long cap = std::min(upperBound - 1, total / 2);
+  // Odtwarzanie trzyma naraz dwie płaszczyzny, po 256 MB najwyżej
+  const long long planeLimit = 1LL << 31;
+  if ((cap + 1) * (cap / 64 + 1) * 64 > planeLimit) {
+    std::cerr << "DP3 (three-machine DP) requires Cmax bound below 46000!\n";
+    return false;
+  }
+  std::vector<int> p(n);
+  for (int j = 0; j < n; ++j)
+    p[j] = tasks[j].pj;
+
+  // Najlepszy osiągalny punkt (a, b) z load3 = total - a - b <= cap
+  long long best = upperBound;
+  int bestA = -1, bestB = -1;
+  {
+    std::vector<uint64_t> plane;
+    loadPlane(p, 0, n, cap, cap, cap, plane);
+    const int words = cap / 64 + 1;
+    for (int a = 0; a <= cap; ++a) {
+      long long from = std::max<long long>(0, total - a - cap);
+      long long to = std::min<long long>(cap, total - a);
+      for (long long b = from; b <= to; ++b) {
+        if (!(plane[(size_t)a * words + b / 64] >> (b % 64) & 1))
+          continue;
+        long long cmax = std::max({(long long)a, b, total - a - b});
+        if (cmax < best) {
+          best = cmax;
+          bestA = a;
+          bestB = b;
+        }
+      }
+    }
+  }
+  if (bestA < 0)
+    return true; // LPT jest optymalny
 
-  std::cout << "  Algorithm: opt, Cmax: " << minCmax;
+  std::vector<int> assign(n);
+  splitThree(p, 0, n, bestA, bestB, assign);
+  result.adopt(tasks, std::move(assign));
+  return true;
 }
\ No newline at end of file
@@ -2,13 +2,21 @@
 #define ALGORITHMS_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <mutex>
+#include <queue>
+#include <set>
 #include <sstream>
 #include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 struct Task {
@@ -18,19 +26,132 @@ struct Task {
 struct Machine {
   int index;
   std::vector<Task> tasksToDo;
-  int Cmax;
+  long long Cmax;
+};
+// Ograniczenia dolne Cmax (Dell'Amico, Martello)
+struct LowerBounds {
+  long long l0; // max(p_max, ceil(sum / m))
+  long long l1; // p_m + p_m+1 i uogólnienie na km + 1 największych
+  long long l2; // z ograniczenia L2 pakowania w pojemniki
+  long long best() const { return std::max({l0, l1, l2}); }
+};
+// Grupa zadań o tym samym czasie (postać o dużej krotności)
+struct TaskGroup {
+  int pj;
+  int count;
+};
+
+// Płaski przydział zadań - wynik algorytmów: machineOf[j] - maszyna zadania
+// j (pozycji j w wektorze zadań po algorytmie), load[k] - obciążenie maszyny
+// k. Listy zadań maszyn powstają dopiero na żądanie (views, applyAssignment
+// przy wypisywaniu), więc algorytmy nie kopiują zadań ani nie alokują list.
+struct Assignment {
+  std::vector<int> machineOf;
+  std::vector<long long> load;
+
+  Assignment(int n, int m) : machineOf(n, -1), load(m, 0) {}
+  void assign(int task, int machine, int pj) {
+    machineOf[task] = machine;
+    load[machine] += pj;
+  }
+  // Przejmuje gotowy przydział i liczy obciążenia maszyn od nowa
+  void adopt(const std::vector<Task> &tasks, std::vector<int> machineOf);
+  long long cmax() const {
+    return load.empty() ? 0 : *std::max_element(load.begin(), load.end());
+  }
+  void views(std::vector<int> &start, std::vector<int> &order) const;
+};
+
+// Kopiec indeksowany maszyn według obciążenia (minimalny lub maksymalny).
+// Pamięta pozycję każdej maszyny w kopcu, więc zmiana obciążenia dowolnej
+// maszyny kosztuje O(log m). Remisy rozstrzyga mniejszy indeks maszyny.
+struct LoadHeap {
+  std::vector<int> heap;       // indeksy maszyn
+  std::vector<int> pos;        // pozycja maszyny w heap
+  std::vector<long long> load; // obciążenie maszyny
+  bool maxHeap;
+
+  LoadHeap(const std::vector<long long> &loads, bool maxHeap = false);
+  int top() const { return heap[0]; }
+  void update(int machine, long long newLoad);
+
+private:
+  bool before(int a, int b) const;
+  void siftUp(int i);
+  void siftDown(int i);
+};
+
+// Szeregowanie online: zadania przychodzą pojedynczo i od razu trafiają na
+// maszynę. Pamiętane są tylko obciążenia maszyn, nie lista zadań.
+//   Graham - najmniej obciążona maszyna, O(log m), ratio 2 - 1/m
+//   Kpt    - Karger, Phillips, Torng: najwyżej obciążona maszyna, na której
+//            zadanie nie przekroczy alpha * średniej niżej obciążonych,
+//            przegląd od najwyżej obciążonej, O(m), ratio 1.945
+struct OnlineScheduler {
+  enum Policy { Graham, Kpt };
+
+  OnlineScheduler(int machines, Policy policy = Graham);
+  int assign(int pj); // zwraca indeks maszyny
+  long long cmax() const { return maxLoad; }
+  const std::vector<long long> &loads() const { return heap.load; }
+
+private:
+  Policy policy;
+  LoadHeap heap;
+  std::vector<int> order; // maszyny rosnąco wg obciążenia (Kpt)
+  long long total = 0;     // suma obciążeń
+  long long maxLoad = 0;
+};
+
+// Dynamiczny przydział zadań: wstawianie i usuwanie w O(log n + log m).
+// Zadania maszyny trzymane są w zbiorze par (pj, indeks), więc usunięcie i
+// wyszukanie zadania o zadanym czasie są logarytmiczne. Po każdym usunięciu
+// co najwyżej maxMigrations zadań przenosi się z najbardziej na najmniej
+// obciążoną maszynę.
+struct DynamicSchedule {
+  DynamicSchedule(int machines, int maxMigrations = 2);
+  int insert(const Task &task); // zwraca indeks maszyny
+  bool remove(int taskIndex);
+  int rebalance(int migrations); // zwraca liczbę przeniesionych zadań
+  long long cmax() const { return maxHeap.load[maxHeap.top()]; }
+  void toMachines(std::vector<Machine> &machines) const;
+
+private:
+  std::vector<std::set<std::pair<int, int>>> tasks; // (pj, indeks)
+  std::unordered_map<int, std::pair<int, int>> where; // indeks -> (maszyna, pj)
+  LoadHeap minHeap, maxHeap;
+  int maxMigrations;
+
+  void setLoad(int machine, long long load);
 };
 
 void loadTasksFromFile(const std::string &filename, std::vector<Task> &tasks);
 void sortTasks(std::vector<Task> &tasks);
-int calculateCmax(const std::vector<Machine> &machines);
+long long calculateCmax(const std::vector<Machine> &machines);
 void printTasks(const std::vector<Task> &tasks);
-void lpt(std::vector<Task> &tasks, std::vector<Machine> &machines);
-void lsa(std::vector<Task> &tasks, std::vector<Machine> &machines);
-void pd(std::vector<Task> &tasks, std::vector<Machine> &machines);
-void ptas(std::vector<Task> &tasks, std::vector<Machine> &machines);
-void fptas(std::vector<Task> &tasks, std::vector<Machine> &machines);
-void opt(std::vector<Task> &tasks, std::vector<Machine> &machines);
+void lpt(std::vector<Task> &tasks, Assignment &result);
+void lsa(std::vector<Task> &tasks, Assignment &result);
+bool pd(std::vector<Task> &tasks, Assignment &result);
+double ptas(std::vector<Task> &tasks, Assignment &result, double epsilon);
+bool fptas(std::vector<Task> &tasks, Assignment &result, double epsilon);
+void benchmarkFptas(const std::vector<Task> &tasks);
+bool opt(std::vector<Task> &tasks, Assignment &result);
+bool subsetDp(std::vector<Task> &tasks, Assignment &result);
+void multifit(std::vector<Task> &tasks, Assignment &result);
+void karmarkarKarp(std::vector<Task> &tasks, Assignment &result);
+bool completeKarmarkarKarp(std::vector<Task> &tasks, Assignment &result,
+                           bool &optimal, double timeLimitMs = 1000);
+bool meetInTheMiddle(std::vector<Task> &tasks, Assignment &result);
+void groupTasks(std::vector<Task> &tasks, std::vector<TaskGroup> &groups);
+bool highMultiplicity(std::vector<Task> &tasks, Assignment &result);
+bool binCompletion(std::vector<Task> &tasks, Assignment &result);
+bool threeMachineDp(std::vector<Task> &tasks, Assignment &result);
+LowerBounds computeLowerBounds(const std::vector<Task> &tasks, int m);
+int localSearch(const std::vector<Task> &tasks, Assignment &result);
+long long scheduleOnline(std::istream &input, OnlineScheduler &scheduler,
+                         std::ostream *assignments = nullptr);
+void applyAssignment(const std::vector<Task> &tasks, const Assignment &result,
+                     std::vector<Machine> &machines);
 void printMachines(const std::vector<Machine> &machines);
 void createMachines(std::vector<Machine> &machines, int numberOfMachines);
 
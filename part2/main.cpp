@@ -1,6 +1,7 @@
 #include "algorithms.hpp"
 #include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -8,11 +9,88 @@
 namespace fs = std::filesystem;
 
 int main(int argc, char *argv[]) {
-  std::vector<std::string> algorithms = {"lpt",  "lsa",   "pd",
-                                         "ptas", "fptas", "opt"};
+  std::vector<std::string> algorithms = {
+      "lpt", "lsa",      "pd", "ptas", "fptas", "opt",
+      "sdp", "multifit", "kk", "ckk",  "mitm",  "hm", "bc", "dp3"};
   std::chrono::duration<double> elapsed;
   std::string algorithm = "lpt";
   std::string numberOfMachines = "2";
+  double epsilon = 0.2; // dokładność PTAS / FPTAS
+  bool printSchedules = false; // listy zadań maszyn tylko na żądanie
+
+  // Użycie: main [liczba_maszyn] [epsilon] [print]
+  //         main fptas-bench [plik] - czas i pamięć FPTAS dla m = 2..5
+  //         main online m [graham|kpt] [plik|-] - szeregowanie strumieniowe
+  //         main dynamic m [plik] - wstawianie i usuwanie zadań
+  if (argc > 1 && std::string(argv[1]) == "fptas-bench") {
+    std::vector<Task> tasks;
+    loadTasksFromFile(argc > 2 ? argv[2] : "../tests/n20_p50-100.txt", tasks);
+    benchmarkFptas(tasks);
+    return 0;
+  }
+  if (argc > 2 && std::string(argv[1]) == "online") {
+    std::string policy = argc > 3 ? argv[3] : "graham";
+    if (policy != "graham" && policy != "kpt") {
+      std::cerr << "Unknown online policy: " << policy << "\n";
+      return 1;
+    }
+    OnlineScheduler scheduler(std::stoi(argv[2]),
+                              policy == "kpt" ? OnlineScheduler::Kpt
+                                              : OnlineScheduler::Graham);
+    std::string source = argc > 4 ? argv[4] : "-";
+    std::ifstream file;
+    if (source != "-") {
+      file.open(source);
+      if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << source << "\n";
+        return 1;
+      }
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    long long count = scheduleOnline(source == "-" ? std::cin : file,
+                                     scheduler, &std::cout);
+    elapsed = std::chrono::high_resolution_clock::now() - start;
+    std::cerr << "Online: " << policy << ", Tasks: " << count
+              << ", Cmax: " << scheduler.cmax() << ", Time: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                     .count()
+              << " ns\n";
+    return 0;
+  }
+  if (argc > 2 && std::string(argv[1]) == "dynamic") {
+    std::vector<Task> tasks;
+    loadTasksFromFile(argc > 3 ? argv[3] : "../tests/n50_p50-100.txt", tasks);
+    int m = std::stoi(argv[2]);
+    DynamicSchedule schedule(m);
+    auto report = [&](const std::string &phase,
+                      const std::vector<Task> &present) {
+      std::cout << "Dynamic: " << phase << ", Tasks: " << present.size()
+                << ", Cmax: " << schedule.cmax()
+                << ", Lower bound: " << computeLowerBounds(present, m).best()
+                << "\n";
+    };
+    // Wstawienie wszystkich zadań, usunięcie co drugiego i ponowne wstawienie
+    for (const auto &task : tasks)
+      schedule.insert(task);
+    report("insert", tasks);
+    std::vector<Task> kept;
+    for (size_t i = 0; i < tasks.size(); ++i)
+      if (i % 2)
+        schedule.remove(tasks[i].index);
+      else
+        kept.push_back(tasks[i]);
+    report("remove", kept);
+    for (size_t i = 1; i < tasks.size(); i += 2)
+      schedule.insert(tasks[i]);
+    report("reinsert", tasks);
+    return 0;
+  }
+  if (argc > 1)
+    numberOfMachines = argv[1];
+  if (argc > 2)
+    epsilon = std::stod(argv[2]);
+  if (argc > 3)
+    printSchedules = std::string(argv[3]) == "print";
 
   if (std::find(algorithms.begin(), algorithms.end(), algorithm) ==
       algorithms.end()) {
@@ -28,45 +106,94 @@ int main(int argc, char *argv[]) {
     std::string testFile = entry.path().string();
     std::cout << "Test file: " << testFile << "\n";
 
+    std::vector<Task> allTasks;
+    loadTasksFromFile(testFile, allTasks);
+    LowerBounds bounds =
+        computeLowerBounds(allTasks, std::stoi(numberOfMachines));
+    long long lowerBound = bounds.best();
+    std::cout << "  Lower bounds: L0: " << bounds.l0 << ", L1: " << bounds.l1
+              << ", L2: " << bounds.l2 << "\n";
+
     for (const auto &alg : algorithms) {
       std::vector<Task> tasks;
-      std::vector<Machine> machines;
-      createMachines(machines, std::stoi(numberOfMachines));
       loadTasksFromFile(testFile, tasks);
+      Assignment result(tasks.size(), std::stoi(numberOfMachines));
 
+      double guarantee = 0; // gwarancja aproksymacji, jeśli algorytm ją daje
+      bool scheduled = true; // false - algorytm nie obsługuje instancji
       auto start = std::chrono::high_resolution_clock::now();
       if (alg == "lpt") {
-        lpt(tasks, machines);
+        lpt(tasks, result);
       } else if (alg == "lsa") {
-        lsa(tasks, machines);
+        lsa(tasks, result);
       } else if (alg == "pd") {
-        pd(tasks, machines);
+        scheduled = pd(tasks, result);
       } else if (alg == "ptas") {
-        ptas(tasks, machines);
+        guarantee = ptas(tasks, result, epsilon);
       } else if (alg == "fptas") {
-        fptas(tasks, machines);
+        scheduled = fptas(tasks, result, epsilon);
       } else if (alg == "opt") {
-        opt(tasks, machines);
+        scheduled = opt(tasks, result);
+      } else if (alg == "sdp") {
+        scheduled = subsetDp(tasks, result);
+      } else if (alg == "multifit") {
+        multifit(tasks, result);
+      } else if (alg == "kk") {
+        karmarkarKarp(tasks, result);
+      } else if (alg == "ckk") {
+        bool optimal = false;
+        scheduled = completeKarmarkarKarp(tasks, result, optimal);
+        if (optimal)
+          guarantee = 1.0; // przeszukanie pełne - wynik optymalny
+      } else if (alg == "mitm") {
+        scheduled = meetInTheMiddle(tasks, result);
+      } else if (alg == "hm") {
+        scheduled = highMultiplicity(tasks, result);
+      } else if (alg == "bc") {
+        scheduled = binCompletion(tasks, result);
+      } else if (alg == "dp3") {
+        scheduled = threeMachineDp(tasks, result);
       } else {
         std::cerr << "Unknown algorithm: " << alg << "\n";
         continue;
       }
       auto end = std::chrono::high_resolution_clock::now();
       elapsed = end - start;
+      // Bez harmonogramu nie ma Cmax ani luki - nie porównujemy z LB
+      if (!scheduled) {
+        std::cout << "  Algorithm: " << alg << ", not applicable\n";
+        continue;
+      }
 
-      int cmax = calculateCmax(machines);
-      if (alg != "opt") {
-        std::cout << "  Algorithm: " << alg << ", Cmax: " << cmax << ", Time: "
-                  << std::chrono::duration_cast<std::chrono::nanoseconds>(
-                         elapsed)
-                         .count()
-                  << " ns\n";
-      } else if (alg == "opt" && tasks.size() < 20) {
-        std::cout << ", Time: "
-                  << std::chrono::duration_cast<std::chrono::nanoseconds>(
-                         elapsed)
-                         .count()
-                  << " ns\n";
+      long long cmax = result.cmax();
+      std::cout << "  Algorithm: " << alg << ", Cmax: " << cmax;
+      if (guarantee > 0)
+        std::cout << ", Guarantee: " << guarantee;
+      std::cout << ", Gap: " << cmax - lowerBound << ", Time: "
+                << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                       .count()
+                << " ns\n";
+      // Listy zadań maszyn powstają z płaskiego przydziału tylko tutaj
+      if (printSchedules) {
+        std::vector<Machine> machines;
+        applyAssignment(tasks, result, machines);
+        printMachines(machines);
+      }
+      // Poprawa lokalna wyników heurystyk - osobny wynik "alg+ls"; nie
+      // zatrzymuje przeglądu, bo to już nie jest wynik samego algorytmu
+      if ((alg == "lpt" || alg == "lsa" || alg == "ptas" || alg == "fptas") &&
+          cmax > lowerBound) {
+        int exchanges = localSearch(tasks, result);
+        long long improved = result.cmax();
+        std::cout << "  Algorithm: " << alg << "+ls, Cmax: " << improved
+                  << ", Gap: " << improved - lowerBound
+                  << ", Exchanges: " << exchanges << "\n";
+      }
+      // Cmax algorytmu równy ograniczeniu dolnemu jest optymalny - dalej nie
+      // szukamy
+      if (cmax == lowerBound) {
+        std::cout << "  Optimal: " << alg << " matches the lower bound\n";
+        break;
       }
     }
     std::cout << "----------------------------------------\n\n";